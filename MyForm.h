@@ -1,175 +1,8 @@
 #pragma once
-#include <math.h>
-#include <tuple>
-#include <iostream>
-#include <vector>
-const int p = 4; //  -    
+#include "RK_4.h"
+#include "RK_4_tasks.h"
+#include "RK_decimate.h"
 
-/*	
-*	 Runge_Kytta_4 -            4 
-*	     { x_n, v_n } 
-*	double(*f)(double, double) -      
-*	double h_n -    
-*	double x_n -     
-*	double v_n -  v   
-*/
-std::pair<double, double> Runge_Kytta_4(double(*f)(double, double), double h_n, double x_n, double v_n) {
-
-	double k1 = f(x_n, v_n);
-	double k2 = f(x_n + h_n / 2.0, v_n + h_n / 2.0 * k1);
-	double k3 = f(x_n + h_n / 2.0, v_n + h_n / 2.0 * k2);
-	double k4 = f(x_n + h_n, v_n + h_n * k3);
-
-	x_n = x_n + h_n;
-	v_n = v_n + h_n * (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
-	return { x_n, v_n };
-}
-/*	
-*	 Runge_Kytta_4_system -            4 
-*	   
-*	 tuple,       v1  v2, {x_n, v1_n, v2_n}
-*	std::pair<double, double>(*f)(double, double, double, double, double) -      
-*	double h_n -    
-*	double x_n -     
-*	double v1_n -  v1   
-*	double v2_n -  v2   
-*	double a, double b -  
-*/
-std::tuple<double, double, double>Runge_Kytta_4_system(std::pair<double, double>(*f)(double, double, double, double, double), double h_n, double x_n, double v1_n, double v2_n, double a, double b) {
-	double k1_u1 = f(x_n, v1_n, v2_n, a, b).first;
-	double k1_u2 = f(x_n, v1_n, v2_n, a, b).second;
-
-	double k2_u1 = f(x_n + h_n / 2.0, v1_n + h_n / 2.0 * k1_u1, v2_n + h_n / 2.0 * k1_u2, a, b).first;
-	double k2_u2 = f(x_n + h_n / 2.0, v1_n + h_n / 2.0 * k1_u1, v2_n + h_n / 2.0 * k1_u2, a, b).second;
-
-	double k3_u1 = f(x_n + h_n / 2.0, v1_n + h_n / 2.0 * k2_u1, v2_n + h_n / 2.0 * k2_u2, a, b).first;
-	double k3_u2 = f(x_n + h_n / 2.0, v1_n + h_n / 2.0 * k2_u1, v2_n + h_n / 2.0 * k2_u2, a, b).second;
-
-	double k4_u1 = f(x_n + h_n, v1_n + h_n * k3_u1, v2_n + h_n * k3_u2, a, b).first;
-	double k4_u2 = f(x_n + h_n, v1_n + h_n * k3_u1, v2_n + h_n * k3_u2, a, b).second;
-
-	x_n = x_n + h_n;
-	v1_n = v1_n + h_n * (k1_u1 + 2.0 * k2_u1 + 2.0 * k3_u1 + k4_u1) / 6.0;
-	v2_n = v2_n + h_n * (k1_u2 + 2.0 * k2_u2 + 2.0 * k3_u2 + k4_u2) / 6.0;
-
-	return {x_n, v1_n, v2_n};
-}
-/*
-*	 true_trajectory -     
-*	     
-*	double x -    
-*	double u0 -   
-*/
-double true_trajectory(double x, double u0) {
-	return u0 * exp(-2.5 * x);
-}
-/*
-*	 test_function - ,     ,  
-*	    
-*/
-double test_function(double x, double v) {
-	return -2.5 * v;
-}
-/*
-*	 function_1 - ,     ,  1
-*	    
-*/
-double function_1(double x, double v) {
-	return (std::log(x + 1) / (pow(x, 2) + 1)) * pow(v, 2) + v - pow(v, 3) * sin(10 * x);
-}
-/*
-*	 function_2 -  ,     ,  2
-*	    
-*/
-std::pair<double , double> function_2(double x, double u1, double u2, double a, double b) {
-	double du1 = u2;
-	double du2 = -a * pow(u2, 2) - b * sin(u1);
-
-	return { du1, du2 };
-}
-/*
-*	 S -    
-*	    
-*	double v_n -   ,    
-*	double v -   ,       
-*/
-double S(double v_n, double v) {
-	return abs((v_n - v)) / (pow(2, p) - 1);
-}
-/*
-*	 RK_4_OLP - ,    ,      1
-*	double(*f)(double, double) -     
-*	double x0 -     
-*	double u0 -  v   
-*	double h -    
-*	double e -   
-*/
-std::vector<double> RK_4_OLP(double(*f)(double, double), double x0, double u0, double h, double e) {
-	std::pair<double, double> new_point_h;
-	std::pair<double, double> new_point_2h;
-	bool flag = true;
-	double S_new = 0;
-	double swich = 0;
-
-	while (flag) {
-		new_point_h = Runge_Kytta_4(f, h, x0, u0);
-		new_point_2h = Runge_Kytta_4(f, h / 2.0, x0 + h/2.0, Runge_Kytta_4(f, h / 2.0, x0, u0).second);
-		S_new = S(new_point_h.second, new_point_2h.second);
-
-		if (S_new > e) {
-			h /= 2.0;
-			swich -= 1;
-		} else
-		if (S_new < e / pow(2, p + 1)) {
-			flag = false;
-			h *= 2.0;
-			swich += 1;
-		} else 
-		if(S_new >= e / pow(2, p + 1) && S_new < e)
-			flag = false;
-	}
-	std::vector<double> result = { new_point_h.first, new_point_h.second, new_point_2h.second, h, swich};
-	return result;
-}
-/*
-*	 RK_4_OLP_for_system - ,        2
-*	std::pair<double, double>(*f)(double, double, double, double, double) -     
-*	double x0 -     
-*	double u0_1 -  v1   
-*	double u0_2 -  v2   
-*	double h -    
-*	double e -   
-*	double a, double b -  
-*/
-std::vector<double> RK_4_OLP_for_system(std::pair<double, double>(*f)(double, double, double, double, double), double x0, double u0_1, double u0_2, double h, double e, double a, double b) {
-	bool flag = true;
-	std::tuple<double, double, double> new_point_h;
-	std::tuple<double, double, double> new_point_2h;
-	double S1_new = 0;
-	double S2_new = 0;
-	double swich = 0;
-
-	while (flag) {
-		new_point_h = Runge_Kytta_4_system(f, h, x0, u0_1, u0_2, a, b);
-		new_point_2h = Runge_Kytta_4_system(f, h / 2.0, x0 + h / 2.0, std::get<1>(Runge_Kytta_4_system(f, h / 2.0, x0, u0_1, u0_2, a, b)), std::get<2>(Runge_Kytta_4_system(f, h / 2.0, x0, u0_1, u0_2, a, b)), a, b);
-		S1_new = S(std::get<1>(new_point_h), std::get<1>(new_point_2h));
-		S2_new = S(std::get<2>(new_point_h), std::get<2>(new_point_2h));
-
-		if (S1_new > e || S2_new > e) {
-			h /= 2.0;
-			swich -= 1;
-		}
-		else if (S1_new < e / pow(2, p + 1) && S2_new < e / pow(2, p + 1)) {
-			flag = false;
-			h *= 2.0;
-			swich += 1;
-		}
-		else if ((S1_new >= e / pow(2, p + 1) && S1_new < e) || (S2_new >= e / pow(2, p + 1) && S2_new < e))
-			flag = false;
-	}
-	std::vector<double> result = { std::get<0>(new_point_h), std::get<1>(new_point_h), std::get<2>(new_point_h), std::get<1>(new_point_2h), std::get<2>(new_point_2h), h, swich };
-	return result;
-}
 namespace Graph {
 
 	using namespace System;
@@ -180,6 +13,37 @@ namespace Graph {
 	using namespace System::Drawing;
 	using namespace ZedGraph;
 
+	/*
+	*	Column_points -   (x[k], y[k])    Trajectory,    PointPairList
+	*	index -      (decimate)
+	*/
+	public ref class Column_points : public ZedGraph::IPointList {
+	public:
+		Column_points(const double* x, const double* y, cli::array<int>^ index) : x(x), y(y), index(index) {}
+		property int Count { virtual int get() { return index->Length; } }
+		property PointPair^ default[int] { virtual PointPair^ get(int k) { return gcnew PointPair(x[index[k]], y[index[k]]); } }
+		virtual Object^ Clone() { return gcnew Column_points(x, y, index); }
+	private:
+		const double* x;
+		const double* y;
+		cli::array<int>^ index;
+	};
+
+	/*
+	*	True_points -        x
+	*/
+	public ref class True_points : public ZedGraph::IPointList {
+	public:
+		True_points(const double* x, cli::array<int>^ index, double u0) : x(x), index(index), u0(u0) {}
+		property int Count { virtual int get() { return index->Length; } }
+		property PointPair^ default[int] { virtual PointPair^ get(int k) { return gcnew PointPair(x[index[k]], true_trajectory(x[index[k]], u0)); } }
+		virtual Object^ Clone() { return gcnew True_points(x, index, u0); }
+	private:
+		const double* x;
+		cli::array<int>^ index;
+		double u0;
+	};
+
 	/// <summary>
 	/// Summary for MyForm
 	/// </summary>
@@ -189,9 +53,10 @@ namespace Graph {
 		MyForm(void)
 		{
 			InitializeComponent();
-			//
-			//TODO: Add the constructor code here
-			//
+			//     shown->rows    (CellValueNeeded)
+			dataGridView1->VirtualMode = true;
+			dataGridView1->AllowUserToAddRows = false;
+			dataGridView1->CellValueNeeded += gcnew DataGridViewCellValueEventHandler(this, &MyForm::dataGridView1_CellValueNeeded);
 		}
 
 	protected:
@@ -204,6 +69,12 @@ namespace Graph {
 			{
 				delete components;
 			}
+			this->!MyForm();
+		}
+		!MyForm()
+		{
+			delete shown;
+			shown = nullptr;
 		}
 	private: ZedGraph::ZedGraphControl^ zedGraphControl1;
 		   //private: ZedGraph::ZedGraphControl^  zedGraphControl2;
@@ -279,6 +150,11 @@ namespace Graph {
 	private: System::Windows::Forms::TextBox^ textBox23;
 	protected:
 	private: System::ComponentModel::IContainer^ components;
+	//   :      
+	private: Task_result* shown = nullptr;
+	private: bool shown_rounded = false;
+	//       
+	private: Decimation plot_decimation = Decimation::MinMax;
 
 	private:
 		/// <summary>
@@ -1170,22 +1046,24 @@ namespace Graph {
 
 		}
 #pragma endregion
-//      
-	private: System::Void button1_Click(System::Object^ sender, System::EventArgs^ e) {
-
-		GraphPane^ panel = zedGraphControl1->GraphPane;
-		panel->CurveList->Clear();
-		PointPairList^ true_list = gcnew ZedGraph::PointPairList();
-		PointPairList^ test_list = gcnew ZedGraph::PointPairList();
-
-		// ,   
-		double xmin = Convert::ToDouble(textBox1->Text);
-		double xmax = Convert::ToDouble(textBox2->Text);
-		double border = Convert::ToDouble(textBox4->Text);
-		double h = Convert::ToDouble(textBox3->Text);
-		double u0 = Convert::ToDouble(textBox6->Text);
-		std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
+//   
+	private: Task_params read_params() {
+		Task_params params;
+		params.xmin = Convert::ToDouble(textBox1->Text);
+		params.xmax = Convert::ToDouble(textBox2->Text);
+		params.h = Convert::ToDouble(textBox3->Text);
+		params.border = Convert::ToDouble(textBox4->Text);
+		params.u0_1 = Convert::ToDouble(textBox5->Text);
+		params.u0 = Convert::ToDouble(textBox6->Text);
+		params.e = Convert::ToDouble(textBox7->Text);
+		params.u0_2 = Convert::ToDouble(textBox8->Text);
+		params.a = Convert::ToDouble(textBox9->Text);
+		params.b = Convert::ToDouble(textBox10->Text);
+		params.Max_steps = Convert::ToInt64(textBox11->Text);
+		return params;
+	}
+//    
+	private: System::Void clear_output() {
 		textBox12->Clear();
 		textBox13->Clear();
 		textBox14->Clear();
@@ -1198,82 +1076,104 @@ namespace Graph {
 		textBox21->Clear();
 		textBox22->Clear();
 		textBox23->Clear();
-
-		double xmin_limit = xmin - 0.1;
-		double xmax_limit = xmax + 0.1;
-
-		//  
-		int i = 1;
-		dataGridView1->Rows->Clear();
-		double v = u0;
-		double v_last = u0;
-		double v_2h;
-		double v_ist;
-
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-		dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-		dataGridView1->Rows[0]->Cells[2]->Value = floor(v * 10000) / 10000;
-		dataGridView1->Rows[0]->Cells[9]->Value = u0;
-		dataGridView1->Rows[0]->Cells[10]->Value = abs(u0 - v);
-
-		test_list->Add(xmin, v);
-		true_list->Add(xmin, true_trajectory(xmin, u0));
-
-		double x = xmin + h;
-		double max_OLP = 0.0;
-		double max_OLP_x = 0.0;
-		double min_h = h;
-		double max_h = 0;
-		double min_h_x = 0, max_h_x = 0;
-		double max_v_ist_v = 0; double max_v_ist_v_x = 0;
-
-		for (; (x <= xmax) && (i < Max_steps); x += h)
-		{
-			//  
-			true_list->Add(x, true_trajectory(x, u0));
-			//f2_list->Add(x, f2(x));
-			v_last = v;
-			v = Runge_Kytta_4(test_function, h, x, v).second;
-			test_list->Add(x, v);
-
-			//  
-			v_2h = Runge_Kytta_4(test_function, h / 2.0, x + h / 2.0, Runge_Kytta_4(test_function, h / 2.0, x, v_last).second).second;
-			v_ist = floor(true_trajectory(x, u0) * 10000) / 10000;
-			dataGridView1->Rows->Add();
-			dataGridView1->Rows[i]->Cells[0]->Value = i;
-			dataGridView1->Rows[i]->Cells[1]->Value = x;
-			dataGridView1->Rows[i]->Cells[2]->Value = floor(v * 10000) / 10000;
-			dataGridView1->Rows[i]->Cells[3]->Value = floor(v_2h * 10000) / 10000;
-			dataGridView1->Rows[i]->Cells[4]->Value = abs(v - v_2h);
-			dataGridView1->Rows[i]->Cells[5]->Value = S(v, v_2h) * pow(2, p); if (S(v, v_2h) * pow(2, p) > max_OLP) { max_OLP = S(v, v_2h) * pow(2, p); max_OLP_x = x; }
-			dataGridView1->Rows[i]->Cells[6]->Value = h; if (h > max_h) { max_h = h; max_h_x = x; } if (h < min_h) { min_h = h; min_h_x = x; }
-			dataGridView1->Rows[i]->Cells[7]->Value = 0.0;
-			dataGridView1->Rows[i]->Cells[8]->Value = 0.0;
-			dataGridView1->Rows[i]->Cells[9]->Value = v_ist;
-			dataGridView1->Rows[i]->Cells[10]->Value = abs(v_ist - v); if (abs(v_ist - v) > max_v_ist_v) { max_v_ist_v = abs(v_ist - v); max_v_ist_v_x = x; }
-			i++;
+		dataGridView1->RowCount = 0;
+	}
+//    
+	private: System::Void show_summary(const Task_result& result) {
+		textBox12->AppendText(Convert::ToString((Int64)result.n));
+		textBox13->AppendText(Convert::ToString(result.b_x_n));
+		textBox14->AppendText(Convert::ToString(result.stats.max_OLP.value));
+		textBox15->AppendText(Convert::ToString(result.stats.max_h.value));
+		textBox16->AppendText(Convert::ToString(result.stats.max_h.x));
+		textBox17->AppendText(Convert::ToString(result.stats.min_h.value));
+		textBox18->AppendText(Convert::ToString(result.stats.min_h.x));
+		textBox19->AppendText(Convert::ToString(result.stats.max_OLP.x));
+		textBox20->AppendText(Convert::ToString((Int64)result.stats.C2_amount));
+		textBox21->AppendText(Convert::ToString((Int64)result.stats.C1_amount));
+		textBox22->AppendText(Convert::ToString(result.stats.max_u_v.value));
+		textBox23->AppendText(Convert::ToString(result.stats.max_u_v.x));
+		show_failure(result);
+	}
+//    ,      (  inf  nan),
+//       
+	private: System::Void show_failure(const Task_result& result) {
+		if (result.failed)
+			MessageBox::Show("      x = " + Convert::ToString(read_params().xmax - result.b_x_n) +
+				":    e (inf  nan)    ", " ");
+		if (result.output_failed)
+			MessageBox::Show("      ", " ");
+	}
+//   ,     
+	private: Task_result& keep(Task_result&& result) {
+		delete shown;
+		shown = new Task_result(std::move(result));
+		return *shown;
+	}
+//   ,  rounded  v  v_2h   4 
+	private: System::Void show_table(const Task_result& result, bool rounded) {
+		shown_rounded = rounded;
+		dataGridView1->RowCount = (int)result.rows.size();
+	}
+//    (  dataGridView1)
+	private: System::Void dataGridView1_CellValueNeeded(System::Object^ sender, DataGridViewCellValueEventArgs^ e) {
+		if (shown == nullptr || e->RowIndex >= (int)shown->rows.size())
+			return;
+		const Trajectory& rows = shown->rows;
+		std::size_t k = e->RowIndex;
+		bool rounded = shown_rounded || k == 0;
+		if (k == 0 && e->ColumnIndex > 2 && e->ColumnIndex < 9)
+			return;
+		switch (e->ColumnIndex) {
+		case 0: e->Value = (Int64)rows.i[k]; break;
+		case 1: e->Value = rows.x[k]; break;
+		case 2: e->Value = rounded ? floor(rows.v[k] * 10000) / 10000 : rows.v[k]; break;
+		case 3: e->Value = rounded ? floor(rows.v_2h[k] * 10000) / 10000 : rows.v_2h[k]; break;
+		case 4: e->Value = rows.v_v_2h[k]; break;
+		case 5: e->Value = rows.OLP[k]; break;
+		case 6: e->Value = rows.h[k]; break;
+		case 7: e->Value = (Int64)rows.C1[k]; break;
+		case 8: e->Value = (Int64)rows.C2[k]; break;
+		case 9: if (rows.has_true_solution()) e->Value = rows.u[k]; break;
+		case 10: if (rows.has_true_solution()) e->Value = rows.u_v[k]; break;
 		}
-		LineItem^ Curve1 = panel->AddCurve("true_trajectory(x)", true_list, Color::Red, SymbolType::Plus);
-		LineItem^ Curve2 = panel->AddCurve("test_function(x)", test_list, Color::Blue, SymbolType::None);
-
-		textBox12->AppendText(Convert::ToString(i));
-		textBox13->AppendText(Convert::ToString(xmax - x+h));
-		textBox14->AppendText(Convert::ToString(max_OLP));
-		textBox15->AppendText(Convert::ToString(max_h));
-		textBox16->AppendText(Convert::ToString(max_h_x));
-		textBox17->AppendText(Convert::ToString(min_h));
-		textBox18->AppendText(Convert::ToString(min_h_x));
-		textBox19->AppendText(Convert::ToString(max_OLP_x));
-		textBox20->AppendText(Convert::ToString(0));
-		textBox21->AppendText(Convert::ToString(0));
-		textBox22->AppendText(Convert::ToString(max_v_ist_v));
-		textBox23->AppendText(Convert::ToString(max_v_ist_v_x));
-
+	}
+//    (x[k], y[k]),    
+	private: cli::array<int>^ plot_index(const std::vector<double>& x, const std::vector<double>& y) {
+		std::vector<std::size_t> kept = decimate(x.data(), y.data(), x.size(), plot_decimation, zedGraphControl1->Width);
+		cli::array<int>^ index = gcnew cli::array<int>((int)kept.size());
+		for (int k = 0; k < index->Length; k++)
+			index[k] = (int)kept[k];
+		return index;
+	}
+//  
+	private: System::Void show_plot(const Task_result& result, double xmin, double xmax, double u0, System::String^ name) {
+		GraphPane^ panel = zedGraphControl1->GraphPane;
+		panel->CurveList->Clear();
+		const Trajectory& rows = result.rows;
+		if (rows.empty()) {
+			update_axis(xmin, xmax);
+			return;
+		}
+		cli::array<int>^ index_1 = plot_index(rows.x, rows.v);
+		Column_points^ list_1 = gcnew Column_points(rows.x.data(), rows.v.data(), index_1);
+
+		if (result.has_true_solution)
+			panel->AddCurve("true_trajectory(x)", gcnew True_points(rows.x.data(), index_1, u0), Color::Red, SymbolType::Plus);
+		if (result.is_system) {
+			panel->AddCurve("v_1(x)", list_1, Color::Green, SymbolType::None);
+			panel->AddCurve("v_2(x)", gcnew Column_points(rows.x.data(), rows.v2.data(), plot_index(rows.x, rows.v2)), Color::Blue, SymbolType::None);
+		}
+		else
+			panel->AddCurve(name, list_1, Color::Blue, SymbolType::None);
 
+		update_axis(xmin, xmax);
+	}
+//   
+	private: System::Void update_axis(double xmin, double xmax) {
+		GraphPane^ panel = zedGraphControl1->GraphPane;
 		//       X
-		panel->XAxis->Scale->Min = xmin_limit;
-		panel->XAxis->Scale->Max = xmax_limit;
+		panel->XAxis->Scale->Min = xmin - 0.1;
+		panel->XAxis->Scale->Max = xmax + 0.1;
 		/*
 				//       Y
 				panel->YAxis->Scale->Min = ymin_limit;
@@ -1285,773 +1185,83 @@ namespace Graph {
 		zedGraphControl1->AxisChange();
 		//  
 		zedGraphControl1->Invalidate();
+	}
+//      
+	private: System::Void button1_Click(System::Object^ sender, System::EventArgs^ e) {
+		Task_params params = read_params();
+		clear_output();
+		Task_result& result = keep(run_test_fixed(params));
 
+		show_plot(result, params.xmin, params.xmax, params.u0, "test_function(x)");
+		show_table(result, true);
+		show_summary(result);
 	}
 //      
 	private: System::Void button3_Click(System::Object^ sender, System::EventArgs^ e) {
+		Task_params params = read_params();
+		clear_output();
+		Task_result& result = keep(run_test_adaptive(params));
 
-		GraphPane^ panel = zedGraphControl1->GraphPane;
-		panel->CurveList->Clear();
-		PointPairList^ true_list = gcnew ZedGraph::PointPairList();
-		PointPairList^ test_list = gcnew ZedGraph::PointPairList();
-
-		// ,   
-		double xmin = Convert::ToDouble(textBox1->Text);
-		double xmax = Convert::ToDouble(textBox2->Text);
-		double e_0 = Convert::ToDouble(textBox7->Text);
-		double border = Convert::ToDouble(textBox4->Text);
-		std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-		textBox12->Clear();
-		textBox13->Clear();
-		textBox14->Clear();
-		textBox15->Clear();
-		textBox16->Clear();
-		textBox17->Clear();
-		textBox18->Clear();
-		textBox19->Clear();
-		textBox20->Clear();
-		textBox21->Clear();
-		textBox22->Clear();
-		textBox23->Clear();
-
-		double h = Convert::ToDouble(textBox3->Text);
-		double u0 = Convert::ToDouble(textBox6->Text);
-
-		double xmin_limit = xmin - 0.1;
-		double xmax_limit = xmax + 0.1;
-		//  
-		int i = 1;
-		dataGridView1->Rows->Clear();
-		double v = u0;
-		double v_last = u0;
-		double last_h = 0;
-		double v_2h;
-		double v_ist;
-		std::size_t C1 = 0, C2 = 0;
-		std::size_t C1_amount = 0, C2_amount = 0;
-
-		//test_list->Add(xmin, u0);
-		std::vector<double> new_point, last_point;
-		new_point = { xmin, v, h };
-
-		test_list->Add(xmin, u0);
-		true_list->Add(xmin, true_trajectory(xmin, u0));
-
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-		dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-		dataGridView1->Rows[0]->Cells[2]->Value = floor(v * 10000) / 10000;
-		dataGridView1->Rows[0]->Cells[9]->Value = u0;
-		dataGridView1->Rows[0]->Cells[10]->Value = abs(u0 - v);
-
-		double x = xmin;
-		double max_OLP = 0.0;
-		double max_OLP_x = 0.0;
-		double min_h = h;
-		double max_h = 0;
-		double min_h_x = 0, max_h_x = 0;
-		double max_v_ist_v = 0; double max_v_ist_v_x = 0;
-
-		for (; (x < xmax - border) && (i < Max_steps); ) {
-
-			//  
-			last_h = h;
-			last_point = new_point;
-
-			new_point = RK_4_OLP(test_function, x, v, h, e_0);
-
-			x = new_point[0];
-
-			if (x > xmax) {
-				new_point = RK_4_OLP(test_function, last_point[0], v, xmax - last_point[0], e_0);
-				x = new_point[0];
-				if (xmax - last_point[0] - h > last_h) {
-					C1 = 0; C2 = 0;
-				}
-			}
-			else {
-				if (new_point[4] < 0)
-					C1 = new_point[4] * -1;
-				if (new_point[4] > 0) {
-					C2 = 1;
-					if (x + h > xmax)
-						C2 = 0;
-				}
-			}
-
-			x = new_point[0];
-			v = new_point[1];
-			v_2h = new_point[2];
-			h = new_point[3];
-
-			test_list->Add(x, v);
-			true_list->Add(x, true_trajectory(x, u0));
-			//  
-			v_ist = true_trajectory(x, u0);
-			dataGridView1->Rows->Add();
-			dataGridView1->Rows[i]->Cells[0]->Value = i;
-			dataGridView1->Rows[i]->Cells[1]->Value = x;
-			dataGridView1->Rows[i]->Cells[2]->Value = v;
-			dataGridView1->Rows[i]->Cells[3]->Value = v_2h;
-			dataGridView1->Rows[i]->Cells[4]->Value = abs(v - v_2h);
-			dataGridView1->Rows[i]->Cells[5]->Value = abs(v - v_2h) * pow(2, p); if (abs(v - v_2h) * pow(2, p) > max_OLP) { max_OLP = abs(v - v_2h) * pow(2, p); max_OLP_x = x; }
-			dataGridView1->Rows[i]->Cells[6]->Value = x - last_point[0]; if (x - last_point[0] > max_h) { max_h = x - last_point[0]; max_h_x = x; } if (x - last_point[0] < min_h) { min_h = x - last_point[0]; min_h_x = x; }
-			dataGridView1->Rows[i]->Cells[7]->Value = C1;
-			dataGridView1->Rows[i]->Cells[8]->Value = C2;
-			dataGridView1->Rows[i]->Cells[9]->Value = v_ist;
-			dataGridView1->Rows[i]->Cells[10]->Value = abs(v_ist - v); if (abs(v_ist - v) > max_v_ist_v) { max_v_ist_v = abs(v_ist - v); max_v_ist_v_x = x; }
-			i++;
-			C1_amount += C1;
-			C2_amount += C2;
-			C1 = 0;
-			C2 = 0;
-		}
-		LineItem^ Curve1 = panel->AddCurve("true_trajectory(x)", true_list, Color::Red, SymbolType::Plus);
-		LineItem^ Curve2 = panel->AddCurve("test_function(x)", test_list, Color::Blue, SymbolType::None);
-
-		textBox12->AppendText(Convert::ToString(i));
-		textBox13->AppendText(Convert::ToString(xmax - x));
-		textBox14->AppendText(Convert::ToString(max_OLP));
-		textBox15->AppendText(Convert::ToString(max_h));
-		textBox16->AppendText(Convert::ToString(max_h_x));
-		textBox17->AppendText(Convert::ToString(min_h));
-		textBox18->AppendText(Convert::ToString(min_h_x));
-		textBox19->AppendText(Convert::ToString(max_OLP_x));
-		textBox20->AppendText(Convert::ToString(C2_amount));
-		textBox21->AppendText(Convert::ToString(C1_amount));
-		textBox22->AppendText(Convert::ToString(max_v_ist_v));
-		textBox23->AppendText(Convert::ToString(max_v_ist_v_x));
-
-
-		//       X
-		panel->XAxis->Scale->Min = xmin_limit;
-		panel->XAxis->Scale->Max = xmax_limit;
-		/*
-				//       Y
-				panel->YAxis->Scale->Min = ymin_limit;
-				panel->YAxis->Scale->Max = ymax_limit;
-		*/
-		//   AxisChange (),     . 
-		//          , 
-		//      ,   
-		zedGraphControl1->AxisChange();
-		//  
-		zedGraphControl1->Invalidate();
+		show_plot(result, params.xmin, params.xmax, params.u0, "test_function(x)");
+		show_table(result, false);
+		show_summary(result);
 	}
 //        2
 	private: System::Void button2_Click(System::Object^ sender, System::EventArgs^ e) {
+		Task_params params = read_params();
+		clear_output();
+		Task_result& result = keep(run_task2_phase(params));
 
 		GraphPane^ panel = zedGraphControl1->GraphPane;
 		panel->CurveList->Clear();
-		PointPairList^ phase_list = gcnew ZedGraph::PointPairList();
-
-		textBox12->Clear();
-		textBox13->Clear();
-		textBox14->Clear();
-		textBox15->Clear();
-		textBox16->Clear();
-		textBox17->Clear();
-		textBox18->Clear();
-		textBox19->Clear();
-		textBox20->Clear();
-		textBox21->Clear();
-		textBox22->Clear();
-		textBox23->Clear();
-
-
-		// ,   
-		double xmin = Convert::ToDouble(textBox1->Text);
-		double xmax = Convert::ToDouble(textBox2->Text);
-		double e_0 = Convert::ToDouble(textBox7->Text);
-		double border = Convert::ToDouble(textBox4->Text);
-		double u0_1 = Convert::ToDouble(textBox5->Text);
-		double u0_2 = Convert::ToDouble(textBox8->Text);
-		double a = Convert::ToDouble(textBox9->Text);
-		double b = Convert::ToDouble(textBox10->Text);
-		std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-		double h = Convert::ToDouble(textBox3->Text);
-
-		double xmin_limit = xmin - 0.1;
-		double xmax_limit = xmax + 0.1;
-
-		//  
-		int i = 1;
-		dataGridView1->Rows->Clear();
-		double v_1 = u0_1;
-		double v_2 = u0_2;
-		double v_last_1 = u0_1;
-		double v_last_2 = u0_2;
-		double v_2h_1;
-		double v_2h_2;
-		std::size_t C1 = 0, C2 = 0, last_h = 0;
-
-		//test_list->Add(xmin, u0);
-		std::vector<double> new_point, last_point;
-		new_point = { xmin, v_1, v_2, h };
-
-		phase_list->Add(v_1, v_2);
-
-		double x = xmin;
-		double max_OLP = 0.0;
-		double min_h = h;
-		double max_h = 0;
-		double min_h_x = 0, max_h_x = 0;
-
-		for (; (x <= xmax - border) && (i < Max_steps); ) {
-			//  
-			last_h = h;
-			last_point = new_point;
-
-			new_point = RK_4_OLP_for_system(function_2, x, v_1, v_2, h, e_0, a, b);
-
-			x = new_point[0];
-			v_1 = new_point[1];
-			v_2 = new_point[2];
-			v_2h_1 = new_point[3];
-			v_2h_2 = new_point[4];
-			h = new_point[5];
-
-			phase_list->Add(v_1, v_2);
-			i++;
-		}
+		Column_points^ phase_list = gcnew Column_points(result.rows.v.data(), result.rows.v2.data(), plot_index(result.rows.v, result.rows.v2));
 		LineItem^ Curve1 = panel->AddCurve("phase_portrait", phase_list, Color::Green, SymbolType::None);
 
-		textBox12->AppendText(Convert::ToString(i));
-
-		//       X
-		panel->XAxis->Scale->Min = xmin_limit;
-		panel->XAxis->Scale->Max = xmax_limit;
-		/*
-				//       Y
-				panel->YAxis->Scale->Min = ymin_limit;
-				panel->YAxis->Scale->Max = ymax_limit;
-		*/
-		//   AxisChange (),     . 
-		//          , 
-		//      ,   
-		zedGraphControl1->AxisChange();
-		//  
-		zedGraphControl1->Invalidate();
-
+		textBox12->AppendText(Convert::ToString((Int64)result.n));
+		update_axis(params.xmin, params.xmax);
+		show_failure(result);
 	}
 //  1    
 	private: System::Void button4_Click(System::Object^ sender, System::EventArgs^ e) {
+		Task_params params = read_params();
+		clear_output();
+		Task_result& result = keep(run_task1_adaptive(params));
 
-		GraphPane^ panel = zedGraphControl1->GraphPane;
-		panel->CurveList->Clear();
-		PointPairList^ function_list = gcnew ZedGraph::PointPairList();
-
-		// ,   
-		double xmin = Convert::ToDouble(textBox1->Text);
-		double xmax = Convert::ToDouble(textBox2->Text);
-		double e_0 = Convert::ToDouble(textBox7->Text);
-		double border = Convert::ToDouble(textBox4->Text);
-		std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-		textBox12->Clear();
-		textBox13->Clear();
-		textBox14->Clear();
-		textBox15->Clear();
-		textBox16->Clear();
-		textBox17->Clear();
-		textBox18->Clear();
-		textBox19->Clear();
-		textBox20->Clear();
-		textBox21->Clear();
-		textBox22->Clear();
-		textBox23->Clear();
-
-		double h = Convert::ToDouble(textBox3->Text);
-		double u0 = Convert::ToDouble(textBox6->Text);
-
-		double xmin_limit = xmin - 0.1;
-		double xmax_limit = xmax + 0.1;
-
-		//  
-		int i = 1;
-		dataGridView1->Rows->Clear();
-		double v = u0;
-		double v_last = u0;
-		double v_2h;
-		std::size_t C1 = 0, C2 = 0, last_h = 0;
-		std::size_t C1_amount = 0, C2_amount = 0;
-
-		//test_list->Add(xmin, u0);
-		std::vector<double> new_point, last_point;
-		new_point = { xmin, v, h };
-
-		function_list->Add(xmin, u0);
-
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-		dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-		dataGridView1->Rows[0]->Cells[2]->Value = floor(v * 10000) / 10000;
-		//dataGridView1->Rows[0]->Cells[9]->Value = u0;
-		//dataGridView1->Rows[0]->Cells[10]->Value = abs(u0 - v);
-
-		double x = xmin;
-		double max_OLP = 0;
-		double max_OLP_x = 0;
-		double min_h = h;
-		double max_h = 0;
-		double min_h_x = 0, max_h_x = 0;
-
-		for (; (x < xmax - border) && (i < Max_steps); ) {
-			//  
-			last_h = h;
-			last_point = new_point;
-
-			new_point = RK_4_OLP(function_1, x, v, h, e_0);
-
-			x = new_point[0];
-
-
-			if (x > xmax) {
-				new_point = RK_4_OLP(function_1, last_point[0], v, xmax - last_point[0], e_0);
-				x = new_point[0];
-				if (xmax - last_point[0] - h > last_h) {
-					C1 = 0; C2 = 0;
-				}
-			}
-			else {
-				if (new_point[4] < 0)
-					C1 = new_point[4] * -1;
-				if (new_point[4] > 0) {
-					C2 = 1;
-					if (x + h > xmax)
-						C2 = 0;
-				}
-			}
-
-			x = new_point[0];
-			v = new_point[1];
-			v_2h = new_point[2];
-			h = new_point[3];
-
-			function_list->Add(x, v);
-			//  
-			dataGridView1->Rows->Add();
-			dataGridView1->Rows[i]->Cells[0]->Value = i;
-			dataGridView1->Rows[i]->Cells[1]->Value = x;
-			dataGridView1->Rows[i]->Cells[2]->Value = v;
-			dataGridView1->Rows[i]->Cells[3]->Value = v_2h;
-			dataGridView1->Rows[i]->Cells[4]->Value = abs(v - v_2h);
-			dataGridView1->Rows[i]->Cells[5]->Value = abs(v - v_2h) * pow(2, p); if (abs(v - v_2h) * pow(2, p) > max_OLP) { max_OLP = abs(v - v_2h) * pow(2, p); max_OLP_x = x; }
-			dataGridView1->Rows[i]->Cells[6]->Value = x - last_point[0]; if (x - last_point[0] > max_h) { max_h = x - last_point[0]; max_h_x = x; } if (x - last_point[0] < min_h) { min_h = x - last_point[0]; min_h_x = x; }
-			dataGridView1->Rows[i]->Cells[7]->Value = C1;
-			dataGridView1->Rows[i]->Cells[8]->Value = C2;
-			//dataGridView1->Rows[i]->Cells[9]->Value = 0;
-			//dataGridView1->Rows[i]->Cells[10]->Value = 0;
-			i++;
-			C1_amount += C1;
-			C2_amount += C2;
-			C1 = 0;
-			C2 = 0;
-		}
-		LineItem^ Curve1 = panel->AddCurve("function_1(x)", function_list, Color::Blue, SymbolType::None);
-		//LineItem Curve2 = panel->AddCurve("test_function(x)", test_list, Color::Blue, SymbolType::None);
-
-		textBox12->AppendText(Convert::ToString(i));
-		textBox13->AppendText(Convert::ToString(xmax - x));
-		textBox14->AppendText(Convert::ToString(max_OLP));
-		textBox15->AppendText(Convert::ToString(max_h));
-		textBox16->AppendText(Convert::ToString(max_h_x));
-		textBox17->AppendText(Convert::ToString(min_h));
-		textBox18->AppendText(Convert::ToString(min_h_x));
-		textBox19->AppendText(Convert::ToString(max_OLP_x));
-		textBox20->AppendText(Convert::ToString(C2_amount));
-		textBox21->AppendText(Convert::ToString(C1_amount));
-		textBox22->AppendText(Convert::ToString(0));
-		textBox23->AppendText(Convert::ToString(0));
-
-		//       X
-		panel->XAxis->Scale->Min = xmin_limit;
-		panel->XAxis->Scale->Max = xmax_limit;
-		/*
-				//       Y
-				panel->YAxis->Scale->Min = ymin_limit;
-				panel->YAxis->Scale->Max = ymax_limit;
-		*/
-		//   AxisChange (),     . 
-		//          , 
-		//      ,   
-		zedGraphControl1->AxisChange();
-		//  
-		zedGraphControl1->Invalidate();
+		show_plot(result, params.xmin, params.xmax, params.u0, "function_1(x)");
+		show_table(result, false);
+		show_summary(result);
 	}
 	private: System::Void zedGraphControl1_Load(System::Object^ sender, System::EventArgs^ e) {};
 
 //  1    
 private: System::Void button5_Click(System::Object^ sender, System::EventArgs^ e) {
+	Task_params params = read_params();
+	clear_output();
+	Task_result& result = keep(run_task1_fixed(params));
 
-	GraphPane^ panel = zedGraphControl1->GraphPane;
-	panel->CurveList->Clear();
-	PointPairList^ test_list = gcnew ZedGraph::PointPairList();
-
-	// ,   
-	double xmin = Convert::ToDouble(textBox1->Text);
-	double xmax = Convert::ToDouble(textBox2->Text);
-	double border = Convert::ToDouble(textBox4->Text);
-	double h = Convert::ToDouble(textBox3->Text);
-	double u0 = Convert::ToDouble(textBox6->Text);
-	std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-	textBox12->Clear();
-	textBox13->Clear();
-	textBox14->Clear();
-	textBox15->Clear();
-	textBox16->Clear();
-	textBox17->Clear();
-	textBox18->Clear();
-	textBox19->Clear();
-	textBox20->Clear();
-	textBox21->Clear();
-	textBox22->Clear();
-	textBox23->Clear();
-
-	double xmin_limit = xmin - 0.1;
-	double xmax_limit = xmax + 0.1;
-	//  
-	int i = 1;
-	dataGridView1->Rows->Clear();
-	double v = u0;
-	double v_last = u0;
-	double v_2h;
-
-	dataGridView1->Rows->Add();
-	dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-	dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-	dataGridView1->Rows[0]->Cells[2]->Value = floor(v * 10000) / 10000;
-
-	test_list->Add(xmin, v);
-
-	double x = xmin + h;
-	double max_OLP = 0.0;
-	double max_OLP_x = 0.0;
-	double min_h = h;
-	double max_h = 0;
-	double min_h_x = 0, max_h_x = 0;
-
-	for (; (x <= xmax) && (i < Max_steps); x += h)
-	{
-		//  
-		v_last = v;
-		v = Runge_Kytta_4(function_1, h, x, v).second;
-		test_list->Add(x, v);
-
-		//  
-		v_2h = Runge_Kytta_4(function_1, h / 2.0, x + h / 2.0, Runge_Kytta_4(function_1, h / 2.0, x, v_last).second).second;
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[i]->Cells[0]->Value = i;
-		dataGridView1->Rows[i]->Cells[1]->Value = x;
-		dataGridView1->Rows[i]->Cells[2]->Value = floor(v * 10000) / 10000;
-		dataGridView1->Rows[i]->Cells[3]->Value = floor(v_2h * 10000) / 10000;
-		dataGridView1->Rows[i]->Cells[4]->Value = abs(v - v_2h);
-		dataGridView1->Rows[i]->Cells[5]->Value = S(v, v_2h) * pow(2, p); if (S(v, v_2h) * pow(2, p) > max_OLP) { max_OLP = S(v, v_2h) * pow(2, p); max_OLP_x = x; }
-		dataGridView1->Rows[i]->Cells[6]->Value = h; if (h > max_h) { max_h = h; max_h_x = x; } if (h < min_h) { min_h = h; min_h_x = x; }
-		dataGridView1->Rows[i]->Cells[7]->Value = 0.0;
-		dataGridView1->Rows[i]->Cells[8]->Value = 0.0;
-		i++;
-	}
-	LineItem^ Curve2 = panel->AddCurve("function_1(x)", test_list, Color::Blue, SymbolType::None);
-
-	textBox12->AppendText(Convert::ToString(i));
-	textBox13->AppendText(Convert::ToString(xmax - x+h));
-	textBox14->AppendText(Convert::ToString(max_OLP));
-	textBox15->AppendText(Convert::ToString(max_h));
-	textBox16->AppendText(Convert::ToString(max_h_x));
-	textBox17->AppendText(Convert::ToString(min_h));
-	textBox18->AppendText(Convert::ToString(min_h_x));
-	textBox19->AppendText(Convert::ToString(max_OLP_x));
-	textBox20->AppendText(Convert::ToString(0));
-	textBox21->AppendText(Convert::ToString(0));
-	textBox22->AppendText(Convert::ToString(0));
-	textBox23->AppendText(Convert::ToString(0));
-
-	//       X
-	panel->XAxis->Scale->Min = xmin_limit;
-	panel->XAxis->Scale->Max = xmax_limit;
-	/*
-			//       Y
-			panel->YAxis->Scale->Min = ymin_limit;
-			panel->YAxis->Scale->Max = ymax_limit;
-	*/
-	//   AxisChange (),     . 
-	//          , 
-	//      ,   
-	zedGraphControl1->AxisChange();
-	//  
-	zedGraphControl1->Invalidate();
-
+	show_plot(result, params.xmin, params.xmax, params.u0, "function_1(x)");
+	show_table(result, true);
+	show_summary(result);
 }
 //  2    
 private: System::Void button6_Click(System::Object^ sender, System::EventArgs^ e) {
+	Task_params params = read_params();
+	clear_output();
+	Task_result& result = keep(run_task2_fixed(params));
 
-	GraphPane^ panel = zedGraphControl1->GraphPane;
-	panel->CurveList->Clear();
-	PointPairList^ function_2_list_1 = gcnew ZedGraph::PointPairList();
-	PointPairList^ function_2_list_2 = gcnew ZedGraph::PointPairList();
-
-	// ,   
-	double xmin = Convert::ToDouble(textBox1->Text);
-	double xmax = Convert::ToDouble(textBox2->Text);
-	double border = Convert::ToDouble(textBox4->Text);
-	double h = Convert::ToDouble(textBox3->Text);
-	double u0_1 = Convert::ToDouble(textBox5->Text);
-	double u0_2 = Convert::ToDouble(textBox8->Text);
-	double a = Convert::ToDouble(textBox9->Text);
-	double b = Convert::ToDouble(textBox10->Text);
-	std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-	textBox12->Clear();
-	textBox13->Clear();
-	textBox14->Clear();
-	textBox15->Clear();
-	textBox16->Clear();
-	textBox17->Clear();
-	textBox18->Clear();
-	textBox19->Clear();
-	textBox20->Clear();
-	textBox21->Clear();
-	textBox22->Clear();
-	textBox23->Clear();
-
-	double xmin_limit = xmin - 0.1;
-	double xmax_limit = xmax + 0.1;
-	//  
-	int i = 1;
-	dataGridView1->Rows->Clear();
-	double v_1 = u0_1;
-	double v_2 = u0_2;
-	double v_last_1 = u0_1;
-	double v_last_2 = u0_2;
-	double v_2h_1 = 0;
-	double v_2h_2 = 0;
-
-	dataGridView1->Rows->Add();
-	dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-	dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-	dataGridView1->Rows[0]->Cells[2]->Value = floor(v_1 * 10000) / 10000;
-
-	function_2_list_1->Add(xmin, v_1);
-	function_2_list_2->Add(xmin, v_2);
-
-	double x = xmin + h;
-	double max_OLP = 0.0;
-	double max_OLP_x = 0.0;
-	double min_h = h;
-	double max_h = 0;
-	double min_h_x = 0, max_h_x = 0;
-
-	for (; (x <= xmax) && (i < Max_steps); x += h)
-	{
-		//  
-		v_last_1 = v_1;
-		v_last_2 = v_2;
-
-		v_1 = std::get<1>(Runge_Kytta_4_system(function_2, h, x, v_1, v_2, a, b));
-		v_2 = std::get<2>(Runge_Kytta_4_system(function_2, h, x, v_1, v_2, a, b));
-
-		function_2_list_1->Add(x, v_1);
-		function_2_list_2->Add(x, v_2);
-		//  
-		v_2h_1 = std::get<1>(Runge_Kytta_4_system(function_2, h / 2.0, x + h / 2.0, std::get<1>(Runge_Kytta_4_system(function_2, h / 2.0, x, v_last_1, v_last_2, a, b)), std::get<2>(Runge_Kytta_4_system(function_2, h / 2.0, x, v_last_1, v_last_2, a, b)), a, b));
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[i]->Cells[0]->Value = i;
-		dataGridView1->Rows[i]->Cells[1]->Value = x;
-		dataGridView1->Rows[i]->Cells[2]->Value = floor(v_1 * 10000) / 10000;
-		dataGridView1->Rows[i]->Cells[3]->Value = floor(v_2h_1 * 10000) / 10000;
-		dataGridView1->Rows[i]->Cells[4]->Value = abs(v_1 - v_2h_1); 
-		dataGridView1->Rows[i]->Cells[5]->Value = S(v_1, v_2h_1) * pow(2, p); if (S(v_1, v_2h_1) * pow(2, p) > max_OLP) { max_OLP = S(v_1, v_2h_1) * pow(2, p); max_OLP_x = x; }
-		dataGridView1->Rows[i]->Cells[6]->Value = h; if (h > max_h) { max_h = h; max_h_x = x; } if (h < min_h) { min_h = h; min_h_x = x; }
-		dataGridView1->Rows[i]->Cells[7]->Value = 0.0;
-		dataGridView1->Rows[i]->Cells[8]->Value = 0.0;
-		i++;
-	}
-	LineItem^ Curve1 = panel->AddCurve("v_1(x)", function_2_list_1, Color::Green, SymbolType::None);
-	LineItem^ Curve2 = panel->AddCurve("v_2(x)", function_2_list_2, Color::Blue, SymbolType::None);
-
-	textBox12->AppendText(Convert::ToString(i));
-	textBox13->AppendText(Convert::ToString(xmax - x+h));
-	textBox14->AppendText(Convert::ToString(max_OLP));
-	textBox15->AppendText(Convert::ToString(max_h));
-	textBox16->AppendText(Convert::ToString(max_h_x));
-	textBox17->AppendText(Convert::ToString(min_h));
-	textBox18->AppendText(Convert::ToString(min_h_x));
-	textBox19->AppendText(Convert::ToString(max_OLP_x));
-	textBox20->AppendText(Convert::ToString(0));
-	textBox21->AppendText(Convert::ToString(0));
-	textBox22->AppendText(Convert::ToString(0));
-	textBox23->AppendText(Convert::ToString(0));
-
-	//       X
-	panel->XAxis->Scale->Min = xmin_limit;
-	panel->XAxis->Scale->Max = xmax_limit;
-	/*
-			//       Y
-			panel->YAxis->Scale->Min = ymin_limit;
-			panel->YAxis->Scale->Max = ymax_limit;
-	*/
-	//   AxisChange (),     . 
-	//          , 
-	//      ,   
-	zedGraphControl1->AxisChange();
-	//  
-	zedGraphControl1->Invalidate();
-
+	show_plot(result, params.xmin, params.xmax, params.u0, "v_1(x)");
+	show_table(result, true);
+	show_summary(result);
 }
-//  2    
+//  2    
 private: System::Void button7_Click(System::Object^ sender, System::EventArgs^ e) {
-	GraphPane^ panel = zedGraphControl1->GraphPane;
-	panel->CurveList->Clear();
-	PointPairList^ function_1_list = gcnew ZedGraph::PointPairList();
-	PointPairList^ function_2_list = gcnew ZedGraph::PointPairList();
-
-	// ,   
-	double xmin = Convert::ToDouble(textBox1->Text);
-	double xmax = Convert::ToDouble(textBox2->Text);
-	double e_0 = Convert::ToDouble(textBox7->Text);
-	double border = Convert::ToDouble(textBox4->Text);
-	double u0_1 = Convert::ToDouble(textBox5->Text);
-	double u0_2 = Convert::ToDouble(textBox8->Text);
-	double a = Convert::ToDouble(textBox9->Text);
-	double b = Convert::ToDouble(textBox10->Text);
-	std::size_t Max_steps = Convert::ToInt64(textBox11->Text);
-
-	textBox12->Clear();
-	textBox13->Clear();
-	textBox14->Clear();
-	textBox15->Clear();
-	textBox16->Clear();
-	textBox17->Clear();
-	textBox18->Clear();
-	textBox19->Clear();
-	textBox20->Clear();
-	textBox21->Clear();
-	textBox22->Clear();
-	textBox23->Clear();
-
-	double h = Convert::ToDouble(textBox3->Text);
-
-	double xmin_limit = xmin - 0.1;
-	double xmax_limit = xmax + 0.1;
-
-	//  
-	int i = 1;
-	dataGridView1->Rows->Clear();
-	double v_1 = u0_1;
-	double v_2 = u0_2;
-	double v_last_1 = u0_1;
-	double v_last_2 = u0_2;
-	double v_2h_1;
-	double v_2h_2;
-	std::size_t C1 = 0, C2 = 0, last_h = 0;
-	std::size_t C1_amount = 0, C2_amount = 0;
-
-	//test_list->Add(xmin, u0);
-	std::vector<double> new_point, last_point;
-	new_point = { xmin, v_1, v_2, h };
-
-	function_1_list->Add(xmin, v_1);
-	function_2_list->Add(xmin, v_2);
-
-	dataGridView1->Rows->Add();
-	dataGridView1->Rows[0]->Cells[0]->Value = 0.0;
-	dataGridView1->Rows[0]->Cells[1]->Value = xmin;
-	dataGridView1->Rows[0]->Cells[2]->Value = floor(u0_1 * 10000) / 10000;
-
-	double x = xmin;
-	double max_OLP = 0;
-	double max_OLP_x = 0;
-	double min_h = h;
-	double max_h = 0;
-	double min_h_x = 0, max_h_x = 0;
-
-	for (; (x < xmax - border) && (i < Max_steps); ) {
-		//  
-		last_h = h;
-		last_point = new_point;
-
-		new_point = RK_4_OLP_for_system(function_2, x, v_1, v_2, h, e_0, a, b);
-
-		x = new_point[0];
-		if (x > xmax) {
-			new_point = RK_4_OLP_for_system(function_2, last_point[0], v_1, v_2, xmax - last_point[0], e_0, a, b);
-			x = new_point[0];
-			if (xmax - last_point[0] - h > last_h) {
-				C1 = 0; C2 = 0;
-			}
-		}
-		else {
-			if (new_point[6] < 0)
-				C1 = new_point[6] * -1;
-			if (new_point[6] > 0) {
-				C2 = 1;
-				if (x + h > xmax)
-					C2 = 0;
-			}
-		}
-
-		x = new_point[0];
-		v_1 = new_point[1];
-		v_2 = new_point[2];
-		v_2h_1 = new_point[3];
-		v_2h_2 = new_point[4];
-		h = new_point[5];
-
-		function_1_list->Add(x, v_1);
-		function_2_list->Add(x, v_2);
-		//  
-		dataGridView1->Rows->Add();
-		dataGridView1->Rows[i]->Cells[0]->Value = i;
-		dataGridView1->Rows[i]->Cells[1]->Value = x;
-		dataGridView1->Rows[i]->Cells[2]->Value = v_1;
-		dataGridView1->Rows[i]->Cells[3]->Value = v_2h_1;
-		dataGridView1->Rows[i]->Cells[4]->Value = abs(v_1 - v_2h_1);
-		dataGridView1->Rows[i]->Cells[5]->Value = abs(v_1 - v_2h_1) * pow(2, p); if (abs(v_1 - v_2h_1) * pow(2, p) > max_OLP) { max_OLP = abs(v_1 - v_2h_1) * pow(2, p); max_OLP_x = x; }
-		dataGridView1->Rows[i]->Cells[6]->Value = x - last_point[0]; if (x - last_point[0] > max_h) { max_h = x - last_point[0]; max_h_x = x; } if (x - last_point[0] < min_h) { min_h = x - last_point[0]; min_h_x = x; }		dataGridView1->Rows[i]->Cells[7]->Value = C1;
-		dataGridView1->Rows[i]->Cells[8]->Value = C2;
-		//dataGridView1->Rows[i]->Cells[9]->Value = 0;
-		//dataGridView1->Rows[i]->Cells[10]->Value = 0;
-		C1_amount += C1;
-		C2_amount += C2;
-		C1 = 0;
-		C2 = 0;
-		i++;
-	}
-	LineItem^ Curve1 = panel->AddCurve("v_1(x)", function_1_list, Color::Green, SymbolType::None);
-	LineItem^ Curve2 = panel->AddCurve("v_2(x)", function_2_list, Color::Blue, SymbolType::None);
-
-	textBox12->AppendText(Convert::ToString(i));
-	textBox13->AppendText(Convert::ToString(xmax - x));
-	textBox14->AppendText(Convert::ToString(max_OLP));
-	textBox15->AppendText(Convert::ToString(max_h));
-	textBox16->AppendText(Convert::ToString(max_h_x));
-	textBox17->AppendText(Convert::ToString(min_h));
-	textBox18->AppendText(Convert::ToString(min_h_x));
-	textBox19->AppendText(Convert::ToString(max_OLP_x));
-	textBox20->AppendText(Convert::ToString(C2_amount));
-	textBox21->AppendText(Convert::ToString(C1_amount));
-	textBox22->AppendText(Convert::ToString(0));
-	textBox23->AppendText(Convert::ToString(0));
-
-	//       X
-	panel->XAxis->Scale->Min = xmin_limit;
-	panel->XAxis->Scale->Max = xmax_limit;
-	/*
-			//       Y
-			panel->YAxis->Scale->Min = ymin_limit;
-			panel->YAxis->Scale->Max = ymax_limit;
-	*/
-	//   AxisChange (),     . 
-	//          , 
-	//      ,   
-	zedGraphControl1->AxisChange();
-	//  
-	zedGraphControl1->Invalidate();
+	Task_params params = read_params();
+	clear_output();
+	Task_result& result = keep(run_task2_adaptive(params));
 
+	show_plot(result, params.xmin, params.xmax, params.u0, "v_1(x)");
+	show_table(result, false);
+	show_summary(result);
 }
 };
 }
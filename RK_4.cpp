@@ -0,0 +1,26 @@
+#include "RK_4.h"
+
+double true_trajectory(double x, double u0) {
+	return u0 * exp(-2.5 * x);
+}
+
+double test_function(double x, double v) {
+	return Test_function()(x, v);
+}
+
+double function_1(double x, double v) {
+	return Function_1()(x, v);
+}
+
+void function_2(double x, const double* u, double* du, const double* coeffs) {
+	Function_2{ coeffs[0], coeffs[1] }(x, u, du);
+}
+
+double S(double v_n, double v, int order) {
+	return std::abs((v_n - v)) / (pow(2, order) - 1);
+}
+
+OLP_step<2> RK_4_OLP_for_system(System_rhs f, double x0, double u0_1, double u0_2, double h, double e, double a, double b, Step_controller* control) {
+	const double coeffs[2] = { a, b };
+	return RK_4_OLP_for_system(System_call{ f, coeffs }, x0, State<2>{ u0_1, u0_2 }, h, e, control);
+}
@@ -1,72 +1,230 @@
 #pragma once
-#include <iostream>
+#include <math.h>
+#include <cmath>
+#include <tuple>
 #include <vector>
+#include "RK_4_system.h"
+#include "RK_controller.h"
+#include "RK_explicit.h"
+const int p = Classic_RK4::order; //  -    
 
-
-std::size_t numbers_steps, a, b;
-const int p = 4;
-double e;
-//std::cin << e;
-
-double true_trajectory(double x, double u0) {
-	return u0 * exp(-2.5 * x);
-}
-double test_function(double x, double v) {
-	return -2.5 * v;
+/*
+*	 Runge_Kytta_4 -            4 
+*	     { x_n, v_n }
+*	F f -      f(x, v):   ,   
+*	(     ,      )
+*	double h_n -    
+*	double x_n -    
+*	double v_n -  v  
+*/
+template <class F>
+std::pair<double, double> Runge_Kytta_4(F f, double h_n, double x_n, double v_n) {
+	return explicit_step<Classic_RK4>(f, h_n, x_n, v_n);
 }
-double function_1(double x, double v) {
-	return (std::log(x + 1) / (pow(x, 2) + 1)) * v + v - pow(v, 3) * sin(10 * x);
+/*
+*	 RK_4_step_doubling -  h_n    h_n / 2    4    
+*	 k1        ,     11 
+*	F f -      f(x, v)
+*	double h_n -    
+*	double x_n -    
+*	double v_n -  v  
+*/
+template <class F>
+Step_doubling RK_4_step_doubling(F f, double h_n, double x_n, double v_n) {
+	return explicit_step_doubling<Classic_RK4>(f, h_n, x_n, v_n);
 }
+/*
+*	 true_trajectory -    
+*	     
+*	double x -    
+*	double u0 -  
+*/
+double true_trajectory(double x, double u0);
+/*
+*	 test_function - ,     ,  
+*	    
+*	Test_function -      (   )     
+*/
+struct Test_function {
+	double operator()(double, double v) const {
+		return -2.5 * v;
+	}
+
+	void jacobian(double, double, double* J, double* dfdx) const {
+		J[0] = -2.5;
+		dfdx[0] = 0;
+	}
+};
+double test_function(double x, double v);
+/*
+*	 function_1 - ,     ,  1
+*	    
+*	Function_1 -            (RK_split.h):
+*	 c0 = log(x + 1) / (x^2 + 1), c1 = sin(10 x)    x, f = c0 v^2 + v - v^3 c1
+*/
+struct Function_1 {
+	static const std::size_t coefficient_count = 2;
 
-std::pair<double, double> Runge_Kytta_4(double(*f)(double, double), double h_n, double x_n, double v_n) {
+	static void coefficients(const double* x, double* c, std::size_t count) {
+		for (std::size_t i = 0; i < count; i++)
+			c[i] = std::log(x[i] + 1) / (pow(x[i], 2) + 1);
+		for (std::size_t i = 0; i < count; i++)
+			c[count + i] = sin(10 * x[i]);
+	}
 
-	double k1 = f(x_n, v_n);
-	double k2 = f(x_n + h_n / 2.0, v_n + h_n / 2.0 * k1);
-	double k3 = f(x_n + h_n / 2.0, v_n + h_n / 2.0 * k2);
-	double k4 = f(x_n + h_n, v_n + h_n * k3);
+	double state_terms(const double* c, double v) const {
+		return c[0] * pow(v, 2) + v - pow(v, 3) * c[1];
+	}
 
-	x_n = x_n + h_n;
-	v_n = v_n + h_n * (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
-	return { x_n, v_n };
-}
-double S(double v_n, double v) {
-	return abs((v_n - v)) / (pow(2, p) - 1);
-}
-//void next_point(double v_n, double v, double* h_n, double e) {
-//	double S_ = S(v_n, v);
-//	if (S > e) {  //  
-//		*h_n = *h_n / 2.0;
-//	}
-//	else if (S < e / pow(2, p + 1)) {
-//		*h_n = *h_n * 2.0;
-//	}
-//	else {
-//
-//	}
-//}
+	double operator()(double x, double v) const {
+		double c[coefficient_count];
+		coefficients(&x, c, 1);
+		return state_terms(c, v);
+	}
+
+	// df/dv  df/dx    (RK_stiff.h)
+	void jacobian(double x, double v, double* J, double* dfdx) const {
+		double c[coefficient_count];
+		coefficients(&x, c, 1);
+		const double q = pow(x, 2) + 1;
+		const double dc0 = 1 / ((x + 1) * q) - std::log(x + 1) * 2 * x / pow(q, 2);
+		J[0] = 2 * c[0] * v + 1 - 3 * pow(v, 2) * c[1];
+		dfdx[0] = dc0 * pow(v, 2) - pow(v, 3) * 10 * cos(10 * x);
+	}
+};
+double function_1(double x, double v);
+/*
+*	 function_2 -  ,     ,  2
+*	  du  { du1, du2 }  , coeffs = { a, b }
+*	Function_2 -      f(x, u, du),  a  b    
+*/
+struct Function_2 {
+	double a;
+	double b;
+	void operator()(double, const double* u, double* du) const {
+		du[0] = u[1];
+		du[1] = -a * pow(u[1], 2) - b * sin(u[0]);
+	}
+
+	//      (RK_stiff.h),  x   
+	void jacobian(double, const double* u, double* J, double* dfdx) const {
+		J[0] = 0;
+		J[1] = 1;
+		J[2] = -b * cos(u[0]);
+		J[3] = -2 * a * u[1];
+		dfdx[0] = 0;
+		dfdx[1] = 0;
+	}
+};
+void function_2(double x, const double* u, double* du, const double* coeffs);
+/*
+*	 S -    
+*	   
+*	double v_n -   ,    
+*	double v -   ,       
+*	int order -   (Explicit_stepper::order),   p
+*/
+double S(double v_n, double v, int order = p);
+/*
+*	 RK_4_OLP - ,    ,      1
+*	   OLP_step<1>
+*	F f -      f(x, v) (  ,   )
+*	double x0 -    
+*	double u0 -  v  
+*	double h -    
+*	double e -   
+*	Step_controller* control -   (nullptr -     )
+*/
+template <class F>
+OLP_step<1> RK_4_OLP(F f, double x0, double u0, double h, double e, Step_controller* control = nullptr) {
+	Step_controller halving;
+	if (control == nullptr)
+		control = &halving;
+	Step_doubling new_point;
+	OLP_step<1> result;
+	double factor = 1;
+
+	while (true) {
+		new_point = RK_4_step_doubling(f, h, x0, u0);
+		result.rhs_calls += new_point.rhs_calls;
 
-std::pair<double, double> RK_4_OLP(double(*f)(double, double), double x0, double u0, double h, double e) {
-	std::pair<double, double> new_point_h;
-	std::pair<double, double> new_point_2h;
-	double x_n = x0;
-	double v_n = u0;
-	bool flag = true;
-	double S_new = 0;
-	
-	while (flag) {
-		new_point_h = Runge_Kytta_4(f, h, x0, u0);
-		new_point_2h = Runge_Kytta_4(test_function, h / 2.0, x0, Runge_Kytta_4(test_function, h / 2.0, x0, u0).second);
-		S_new = S(new_point_h.second, new_point_2h.second);
+		bool accepted;
+		{
+			RK_PHASE(Phase::Error);
+			accepted = control->next(S(new_point.v_h, new_point.v_2h) / e, p + 1, factor);
+		}
+		h *= factor;
+		if (accepted) {
+			if (factor > 1)
+				result.swich += 1;
+			break;
+		}
+		result.swich -= 1;
+		if (x0 + h == x0) {
+			result.x_n = x0;
+			result.v[0] = result.v_2h[0] = u0;
+			result.h = h;
+			result.failed = true;
+			return result;
+		}
+	}
+	result.x_n = new_point.x_n;
+	result.v[0] = new_point.v_h;
+	result.v_2h[0] = new_point.v_2h;
+	result.h = h;
+	return result;
+}
+/*
+*	 RK_4_OLP_for_system - ,        2
+*	   OLP_step<2> (v = { v1_n, v2_n }, v_2h = { v1_2h, v2_2h })
+*	F f -     f(x, u, du) (Function_2  , System_call, )
+*	double x0 -    
+*	const State<2>& u0 -  { v1, v2 }   
+*	double h -    
+*	double e -   
+*	Step_controller* control -   (nullptr -     )
+*/
+template <class F>
+OLP_step<2> RK_4_OLP_for_system(F f, double x0, const State<2>& u0, double h, double e, Step_controller* control = nullptr) {
+	Step_controller halving;
+	if (control == nullptr)
+		control = &halving;
+	RK_4_stepper<2, F> stepper(f);
+	OLP_step<2> result;
+	double factor = 1;
 
-		if (S_new > e)
-			h /= 2;
-		else if (S_new < e / pow(2, p + 1)) {
-			flag = false;
-			h *= 2;
+	while (true) {
+		result.x_n = x0 + h;
+		stepper.step_doubling(x0, h, u0, result.v, result.v_2h);
+		bool accepted;
+		{
+			RK_PHASE(Phase::Error);
+			double S_new = std::fmax(S(result.v[0], result.v_2h[0]), S(result.v[1], result.v_2h[1]));
+			accepted = control->next(S_new / e, p + 1, factor);
+		}
+		h *= factor;
+		if (accepted) {
+			if (factor > 1)
+				result.swich += 1;
+			break;
 		}
-		else {
-			flag = false;
+		result.swich -= 1;
+		if (x0 + h == x0) {
+			result.x_n = x0;
+			result.v = result.v_2h = u0;
+			result.failed = true;
+			break;
 		}
 	}
-	return new_point_h;
-}
\ No newline at end of file
+	result.h = h;
+	result.rhs_calls = stepper.rhs_calls;
+	return result;
+}
+/*
+*	 RK_4_OLP_for_system -      System_rhs   a, b
+*	System_rhs f -      
+*	double u0_1 -  v1   
+*	double u0_2 -  v2   
+*	double a, double b -  
+*/
+OLP_step<2> RK_4_OLP_for_system(System_rhs f, double x0, double u0_1, double u0_2, double h, double e, double a, double b, Step_controller* control = nullptr);
@@ -0,0 +1,629 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "RK_4.h"
+#include "RK_4_tasks.h"
+#include "RK_adams.h"
+#include "RK_embedded.h"
+#include "RK_extrapolation.h"
+#include "RK_native.h"
+#include "RK_split.h"
+#include "RK_stiff.h"
+#include "RK_switch.h"
+
+/*
+*	RK_4_bench -       
+*	RK_4_bench [--filter ] [--min-time 0.05] [--repeats 5] [--json bench.json]
+*	  :    (  repeats ),     ,
+*	     ,    
+*	   stdout, --json       
+*/
+
+/*
+*	  :   operator new / operator delete
+*	(    )
+*/
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+	allocations++;
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+/*
+*	Run -   
+*	steps -   (   - ),      
+*/
+struct Run {
+	std::size_t steps = 0;
+	std::size_t rhs_calls = 0;
+	std::size_t accepted = 0;
+	std::size_t rejected = 0;
+	double result = 0;			//   v,      
+};
+
+/*
+*	Bench_case - : ,   ,  e (0 -   )  
+*/
+struct Bench_case {
+	std::string name;
+	std::string kernel;
+	std::string rhs;
+	double e;
+	std::function<Run()> run;
+};
+
+/*
+*	Bench_result -  
+*/
+struct Bench_result {
+	double ns_per_step = 0;		//   
+	double ns_min = 0;			//  
+	double rhs_per_step = 0;
+	double allocs_per_step = 0;
+	Run run;
+};
+
+static const std::size_t Fixed_steps = 1000;
+static const std::size_t Max_steps = 1000000;
+
+/*
+*	 fixed_* - Fixed_steps     [xmin, xmax]
+*	F f -  :    (test_function)   (Test_function)
+*/
+template <class F>
+static Run fixed_scalar(F f, double xmin, double xmax, double u0) {
+	Run run;
+	double h = (xmax - xmin) / Fixed_steps;
+	double x = xmin, v = u0;
+	for (std::size_t i = 0; i < Fixed_steps; i++) {
+		std::pair<double, double> next = Runge_Kytta_4(f, h, x, v);
+		x = next.first;
+		v = next.second;
+	}
+	run.steps = run.accepted = Fixed_steps;
+	run.rhs_calls = 4 * Fixed_steps;
+	run.result = v;
+	return run;
+}
+
+template <class F>
+static Run fixed_doubling(F f, double xmin, double xmax, double u0) {
+	Run run;
+	double h = (xmax - xmin) / Fixed_steps;
+	double x = xmin, v = u0;
+	for (std::size_t i = 0; i < Fixed_steps; i++) {
+		Step_doubling next = RK_4_step_doubling(f, h, x, v);
+		x = next.x_n;
+		v = next.v_h;
+		run.rhs_calls += next.rhs_calls;
+	}
+	run.steps = run.accepted = Fixed_steps;
+	run.result = v;
+	return run;
+}
+
+/*
+*	 split_doubling -  ,  fixed_doubling,       Coefficient_table
+*/
+template <class F>
+static Run split_doubling(F f, double xmin, double xmax, double u0) {
+	Run run;
+	Coefficient_table<F> table;
+	double h = (xmax - xmin) / Fixed_steps;
+	double x = xmin, v = u0;
+	for (std::size_t i = 0; i < Fixed_steps; i++) {
+		if (i % Split_block == 0)
+			table.template fill_step_doubling<Classic_RK4>(x, h, xmax, Split_block);
+		Step_doubling next = RK_4_step_doubling(Split_rhs<F>{ f, &table }, h, x, v);
+		x = next.x_n;
+		v = next.v_h;
+		run.rhs_calls += next.rhs_calls;
+	}
+	run.steps = run.accepted = Fixed_steps;
+	run.result = v;
+	return run;
+}
+
+template <class Tableau, class F>
+static Run fixed_system(F f, double xmin, double xmax, const State<2>& u0, bool doubling) {
+	Run run;
+	Explicit_stepper<Tableau, 2, F> stepper(f);
+	double h = (xmax - xmin) / Fixed_steps;
+	double x = xmin;
+	State<2> v = u0, v_h, v_2h;
+	for (std::size_t i = 0; i < Fixed_steps; i++, x += h) {
+		if (doubling) {
+			stepper.step_doubling(x, h, v, v_h, v_2h);
+			v = v_h;
+		}
+		else
+			stepper.step(x, h, v, v);
+	}
+	run.steps = run.accepted = Fixed_steps;
+	run.rhs_calls = stepper.rhs_calls;
+	run.result = v[0];
+	return run;
+}
+
+/*
+*	 adaptive -      xmin  xmax,    3, 4, 7
+*	OLP(x, v, h, controller) -   OLP_step
+*/
+template <std::size_t N, class OLP>
+static Run adaptive(double xmin, double xmax, double h, const State<N>& u0, OLP olp) {
+	Run run;
+	Step_controller controller;
+	double x = xmin;
+	State<N> v = u0;
+	while (xmax - x > 1e-12 * (1 + std::abs(xmax)) && run.steps < Max_steps) {
+		OLP_step<N> step = olp(x, v, std::fmin(h, xmax - x), controller);
+		if (step.failed)
+			break;
+		x = step.x_n;
+		v = step.v;
+		h = step.h;
+		run.rhs_calls += step.rhs_calls;
+		run.steps++;
+	}
+	run.accepted = controller.accepted;
+	run.rejected = controller.rejected;
+	run.result = v[0];
+	return run;
+}
+
+/*
+*	 scalar_cases -       f (name -    )
+*	function_1     x = 1.09  u0 = 1,    xmax = 1
+*/
+template <class F>
+static void scalar_cases(std::vector<Bench_case>& cases, const char* name, F f, double xmax, const double* tolerances, std::size_t count) {
+	cases.push_back({ std::string("Runge_Kytta_4/") + name, "Runge_Kytta_4", name, 0,
+		[f, xmax] { return fixed_scalar(f, 0, xmax, 1); } });
+	cases.push_back({ std::string("RK_4_step_doubling/") + name, "RK_4_step_doubling", name, 0,
+		[f, xmax] { return fixed_doubling(f, 0, xmax, 1); } });
+	for (std::size_t k = 0; k < count; k++) {
+		double e = tolerances[k];
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/%s/e=%g", name, e);
+		cases.push_back({ std::string("RK_4_OLP") + suffix, "RK_4_OLP", name, e, [f, xmax, e] {
+			return adaptive<1>(0, xmax, 0.1, State<1>{ 1 }, [&](double x, const State<1>& v, double h, Step_controller& control) {
+				return RK_4_OLP(f, x, v[0], h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("RK_embedded_OLP<dp54>") + suffix, "RK_embedded_OLP<dp54>", name, e, [f, xmax, e] {
+			Embedded_stepper<1, Scalar_rhs<F>> stepper(Method::DP54, Scalar_rhs<F>{ f });
+			return adaptive<1>(0, xmax, 0.1, State<1>{ 1 }, [&](double x, const State<1>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	 system_cases -   2    f  [0, 2]
+*	( a = b = 1, u0 = { 1, 1 }     2^-36)
+*/
+template <class F>
+static void system_cases(std::vector<Bench_case>& cases, const char* name, F f, const double* tolerances, std::size_t count) {
+	cases.push_back({ std::string("RK_4_stepper<2>::step/") + name, "RK_4_stepper<2>::step", name, 0,
+		[f] { return fixed_system<Classic_RK4>(f, 0, 2, State<2>{ 1, 1 }, false); } });
+	cases.push_back({ std::string("RK_4_stepper<2>::step_doubling/") + name, "RK_4_stepper<2>::step_doubling", name, 0,
+		[f] { return fixed_system<Classic_RK4>(f, 0, 2, State<2>{ 1, 1 }, true); } });
+	for (std::size_t k = 0; k < count; k++) {
+		double e = tolerances[k];
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/%s/e=%g", name, e);
+		cases.push_back({ std::string("RK_4_OLP_for_system") + suffix, "RK_4_OLP_for_system", name, e, [f, e] {
+			return adaptive<2>(0, 2, 0.1, State<2>{ 1, 1 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_4_OLP_for_system(f, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("RK_embedded_OLP<dp54>") + suffix, "RK_embedded_OLP<dp54>", name, e, [f, e] {
+			Embedded_stepper<2, F> stepper(Method::DP54, f);
+			return adaptive<2>(0, 2, 0.1, State<2>{ 1, 1 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	 tableau_cases -     (RK_explicit.h)   2:
+*	      3/8,       - ,
+*	  ,       Embedded_stepper (  )
+*/
+template <class F>
+static void tableau_cases(std::vector<Bench_case>& cases, F f, const double* tolerances, std::size_t count) {
+	cases.push_back({ "step_doubling<Three_eighths_RK4>/Function_2", "Explicit_stepper<Three_eighths_RK4>::step_doubling", "Function_2", 0,
+		[f] { return fixed_system<Three_eighths_RK4>(f, 0, 2, State<2>{ 1, 1 }, true); } });
+	cases.push_back({ "step_doubling<Ralston_RK2>/Function_2", "Explicit_stepper<Ralston_RK2>::step_doubling", "Function_2", 0,
+		[f] { return fixed_system<Ralston_RK2>(f, 0, 2, State<2>{ 1, 1 }, true); } });
+	cases.push_back({ "step_doubling<Heun_RK2>/Function_2", "Explicit_stepper<Heun_RK2>::step_doubling", "Function_2", 0,
+		[f] { return fixed_system<Heun_RK2>(f, 0, 2, State<2>{ 1, 1 }, true); } });
+	for (std::size_t k = 0; k < count; k++) {
+		double e = tolerances[k];
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/Function_2/e=%g", e);
+		cases.push_back({ std::string("RK_embedded_OLP<bs32>") + suffix, "RK_embedded_OLP<bs32>", "Function_2", e, [f, e] {
+			Embedded_stepper<2, F> stepper(Method::BS32, f);
+			return adaptive<2>(0, 2, 0.1, State<2>{ 1, 1 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("RK_embedded_OLP<Bogacki_Shampine_32>") + suffix, "RK_embedded_OLP<Bogacki_Shampine_32>", "Function_2", e, [f, e] {
+			Explicit_stepper<Bogacki_Shampine_32, 2, F> stepper(f);
+			return adaptive<2>(0, 2, 0.1, State<2>{ 1, 1 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	 adams_cases -   -  -  (RK_adams.h)   RK4  dp54   :
+*	 2  a = 0, b = 1 (, u0 = { 1, 0 })  [0, 100]
+*/
+static void adams_cases(std::vector<Bench_case>& cases, const double* tolerances, std::size_t count) {
+	const Function_2 f{ 0, 1 };
+	for (std::size_t k = 0; k < count; k++) {
+		double e = tolerances[k];
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/Function_2(a=0)/e=%g", e);
+		cases.push_back({ std::string("RK_4_OLP_for_system") + suffix, "RK_4_OLP_for_system", "Function_2(a=0)", e, [f, e] {
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_4_OLP_for_system(f, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("RK_embedded_OLP<dp54>") + suffix, "RK_embedded_OLP<dp54>", "Function_2(a=0)", e, [f, e] {
+			Embedded_stepper<2, Function_2> stepper(Method::DP54, f);
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("Adams_stepper") + suffix, "Adams_stepper", "Function_2(a=0)", e, [f, e] {
+			Adams_stepper<2, Function_2> stepper(f);
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	 extrapolation_cases -   -  -  (RK_extrapolation.h)   RK4  dop853
+*	   ,   adams_cases,   1e-12 (   )
+*/
+static void extrapolation_cases(std::vector<Bench_case>& cases) {
+	const Function_2 f{ 0, 1 };
+	for (double e : { 1e-12 }) {
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/Function_2(a=0)/e=%g", e);
+		cases.push_back({ std::string("RK_4_OLP_for_system") + suffix, "RK_4_OLP_for_system", "Function_2(a=0)", e, [f, e] {
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_4_OLP_for_system(f, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("RK_embedded_OLP<dop853>") + suffix, "RK_embedded_OLP<dop853>", "Function_2(a=0)", e, [f, e] {
+			Embedded_stepper<2, Function_2> stepper(Method::DOP853, f);
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+		cases.push_back({ std::string("Extrapolation_stepper") + suffix, "Extrapolation_stepper", "Function_2(a=0)", e, [f, e] {
+			Extrapolation_stepper<2, Function_2> stepper(f);
+			stepper.tolerance = e;
+			return adaptive<2>(0, 100, 0.1, State<2>{ 1, 0 }, [&](double x, const State<2>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	Stiff_function -   v' = -10^4 (v - cos x):     (h < 3.3e-4  dp54)
+*/
+struct Stiff_function {
+	double operator()(double x, double v) const {
+		return -1e4 * (v - cos(x));
+	}
+
+	void jacobian(double x, double, double* J, double* dfdx) const {
+		J[0] = -1e4;
+		dfdx[0] = -1e4 * sin(x);
+	}
+};
+
+/*
+*	 stiff_cases -   ROS3  SDIRK4 (RK_stiff.h)      (RK_switch.h)
+*	  dp54     [0, 1]
+*/
+static void stiff_cases(std::vector<Bench_case>& cases, const double* tolerances, std::size_t count) {
+	typedef Scalar_rhs<Stiff_function> F;
+	for (std::size_t k = 0; k < count; k++) {
+		double e = tolerances[k];
+		char suffix[64];
+		std::snprintf(suffix, sizeof(suffix), "/Stiff_function/e=%g", e);
+		cases.push_back({ std::string("RK_embedded_OLP<dp54>") + suffix, "RK_embedded_OLP<dp54>", "Stiff_function", e, [e] {
+			Embedded_stepper<1, F> stepper(Method::DP54, F{});
+			return adaptive<1>(0, 1, 0.1, State<1>{ 1 }, [&](double x, const State<1>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+		for (Method method : { Method::ROS3, Method::SDIRK4 }) {
+			const std::string name = std::string("Stiff_stepper<") + method_name(method) + ">";
+			cases.push_back({ name + suffix, name, "Stiff_function", e, [method, e] {
+				Stiff_stepper<1, F> stepper(method, F{});
+				stepper.tolerance = e;
+				return adaptive<1>(0, 1, 0.1, State<1>{ 1 }, [&](double x, const State<1>& v, double h, Step_controller& control) {
+					return RK_embedded_OLP(stepper, x, v, h, e, &control);
+				});
+			} });
+		}
+		cases.push_back({ std::string("Switching_stepper<dp54, ros3>") + suffix, "Switching_stepper<dp54, ros3>", "Stiff_function", e, [e] {
+			Embedded_stepper<1, F> explicit_stepper(Method::DP54, F{});
+			Stiff_stepper<1, F> implicit_stepper(Method::ROS3, F{});
+			Switching_stepper<Embedded_stepper<1, F>, Stiff_stepper<1, F>> stepper(explicit_stepper, implicit_stepper);
+			return adaptive<1>(0, 1, 0.1, State<1>{ 1 }, [&](double x, const State<1>& v, double h, Step_controller& control) {
+				return RK_embedded_OLP(stepper, x, v, h, e, &control);
+			});
+		} });
+	}
+}
+
+/*
+*	 ensemble_cases -   Ensemble_members  (RK_4_ensemble)      
+*	(run_task1_fixed, run_task2_fixed)   1  2  [0, 1]  h = 0.01;   -   
+*	 1: u0 = 1 ... 1.1,  2:  100 x 100  (a, b)  [0, 1] x [0, 1]
+*/
+static const std::size_t Ensemble_members = 10000;
+
+static void ensemble_cases(std::vector<Bench_case>& cases) {
+	Task_params params;
+	params.xmax = 1;
+	params.h = 0.01;
+	std::vector<double> u0(Ensemble_members);
+	std::vector<Task2_member> members(Ensemble_members);
+	for (std::size_t m = 0; m < Ensemble_members; m++) {
+		u0[m] = 1 + 0.1 * m / Ensemble_members;
+		members[m].a = (m % 100) / 100.0;
+		members[m].b = (m / 100) / 100.0;
+	}
+	cases.push_back({ "RK_4_ensemble/Function_1", "RK_4_ensemble", "Function_1", 0, [params, u0] {
+		Run run;
+		std::vector<double> v = run_task1_ensemble(params, u0, &run.steps);
+		run.steps *= u0.size();
+		run.accepted = run.steps;
+		run.rhs_calls = 4 * run.steps;
+		run.result = v[0];
+		return run;
+	} });
+	cases.push_back({ "run_task1_fixed/Function_1", "run_task1_fixed", "Function_1", 0, [params, u0] {
+		Run run;
+		for (double u : u0) {
+			Task_params member = params;
+			member.u0 = u;
+			Task_result result = run_task1_fixed(member, false);
+			run.steps += result.n - 1;
+			run.rhs_calls += result.rhs_calls;
+			run.result += result.v_n;
+		}
+		run.accepted = run.steps;
+		return run;
+	} });
+	cases.push_back({ "RK_4_ensemble/Function_2", "RK_4_ensemble", "Function_2", 0, [params, members] {
+		Run run;
+		std::vector<State<2>> v = run_task2_ensemble(params, members, &run.steps);
+		run.steps *= members.size();
+		run.accepted = run.steps;
+		run.rhs_calls = 4 * run.steps;
+		run.result = v[0][0];
+		return run;
+	} });
+	cases.push_back({ "run_task2_fixed/Function_2", "run_task2_fixed", "Function_2", 0, [params, members] {
+		Run run;
+		for (const Task2_member& member : members) {
+			Task_params task = params;
+			task.u0_1 = member.u0_1;
+			task.u0_2 = member.u0_2;
+			task.a = member.a;
+			task.b = member.b;
+			Task_result result = run_task2_fixed(task, false);
+			run.steps += result.n - 1;
+			run.rhs_calls += result.rhs_calls;
+			run.result += result.v_n;
+		}
+		run.accepted = run.steps;
+		return run;
+	} });
+}
+
+/*
+*	 native_cases -    1  2,     (Native_rhs_library),
+*	   -   Function_1, Function_2;    
+*/
+static void native_cases(std::vector<Bench_case>& cases, const Rhs_program& program_1, const Rhs_program& program_2,
+	const double* coeffs, const double* tolerances, std::size_t count) {
+	static Native_rhs_library native_1, native_2;
+	if (!native_1.load(program_1) || !native_2.load(program_2)) {
+		std::cerr << "RK_4_bench: native cases skipped: " << (native_1.error().empty() ? native_2.error() : native_1.error()) << "\n";
+		return;
+	}
+	scalar_cases(cases, "native:function_1", Native_rhs{ native_1.function(), nullptr }, 1, tolerances, count);
+	system_cases(cases, "native:function_2", Native_rhs{ native_2.function(), coeffs }, tolerances, count);
+}
+
+/*
+*	 bench_cases -  :        (test_function, function_1,
+*	function_2  )     (Test_function, Function_1, Function_2  a  b )
+*/
+static std::vector<Bench_case> bench_cases() {
+	static const double coeffs[2] = { 1, 1 };
+	static const double tolerances[] = { 1e-4, 1e-6, 1e-8, 1e-10 };
+	const std::size_t count = sizeof(tolerances) / sizeof(tolerances[0]);
+	std::vector<Bench_case> cases;
+	scalar_cases(cases, "test_function", test_function, 5, tolerances, count);
+	scalar_cases(cases, "Test_function", Test_function(), 5, tolerances, count);
+	scalar_cases(cases, "function_1", function_1, 1, tolerances, count);
+	scalar_cases(cases, "Function_1", Function_1(), 1, tolerances, count);
+	cases.push_back({ "RK_4_step_doubling/Function_1+Coefficient_table", "RK_4_step_doubling", "Function_1+Coefficient_table", 0,
+		[] { return split_doubling(Function_1(), 0, 1, 1); } });
+	system_cases(cases, "function_2", System_call{ function_2, coeffs }, tolerances, count);
+	system_cases(cases, "Function_2", Function_2{ coeffs[0], coeffs[1] }, tolerances, count);
+	tableau_cases(cases, Function_2{ coeffs[0], coeffs[1] }, tolerances, count);
+	adams_cases(cases, tolerances, count);
+	extrapolation_cases(cases);
+	stiff_cases(cases, tolerances, count);
+	ensemble_cases(cases);
+
+	//    1  2,   (Rhs_program, -), -    Function_1  Function_2
+	static Rhs_program program_1, program_2;
+	static std::vector<double> registers_1, registers_2;
+	if (!program_1.compile({ "log(x+1)/(x^2+1)*v^2 + v - v^3*sin(10*x)" }) ||
+		!program_2.compile({ "v2", "-a*v2^2 - b*sin(v1)" }, { "a", "b" }))
+		throw std::logic_error("cannot compile the benchmark expressions");
+	registers_1 = program_1.registers();
+	registers_2 = program_2.registers(coeffs);
+	scalar_cases(cases, "expr:function_1", Program_rhs{ &program_1, registers_1.data() }, 1, tolerances, count);
+	system_cases(cases, "expr:function_2", Program_rhs{ &program_2, registers_2.data() }, tolerances, count);
+	native_cases(cases, program_1, program_2, coeffs, tolerances, count);
+	return cases;
+}
+
+/*
+*	 measure -  :    run,    min_time 
+*/
+static Bench_result measure(const Bench_case& bench, double min_time, int repeats) {
+	typedef std::chrono::steady_clock clock;
+	Bench_result result;
+	std::size_t before = allocations;
+	result.run = bench.run();
+	std::size_t steps = std::max<std::size_t>(result.run.steps, 1);
+	result.allocs_per_step = (double)(allocations - before) / steps;
+	result.rhs_per_step = (double)result.run.rhs_calls / steps;
+
+	volatile double sink = 0;
+	std::vector<double> samples;
+	for (int r = 0; r < repeats; r++) {
+		std::size_t runs = 0;
+		clock::time_point start = clock::now();
+		double elapsed = 0;
+		do {
+			sink = sink + bench.run().result;
+			runs++;
+			elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		} while (elapsed < min_time);
+		samples.push_back(elapsed * 1e9 / ((double)runs * steps));
+	}
+	std::sort(samples.begin(), samples.end());
+	result.ns_per_step = samples[samples.size() / 2];
+	result.ns_min = samples.front();
+	return result;
+}
+
+/*
+*	 json_string -     JSON (     )
+*/
+static std::string json_string(const std::string& text) {
+	std::string out = "\"";
+	for (char c : text) {
+		if (c == '"' || c == '\\')
+			out += '\\';
+		out += c;
+	}
+	return out + "\"";
+}
+
+static bool write_json(const std::string& path, const std::vector<Bench_case>& cases, const std::vector<Bench_result>& results,
+	double min_time, int repeats) {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (file == nullptr)
+		return false;
+	std::fprintf(file, "{\n  \"min_time\": %g,\n  \"repeats\": %d,\n  \"benchmarks\": [\n", min_time, repeats);
+	for (std::size_t k = 0; k < cases.size(); k++) {
+		const Bench_result& r = results[k];
+		std::fprintf(file, "    { \"name\": %s, \"kernel\": %s, \"rhs\": %s, \"e\": %g, \"ns_per_step\": %.3f, \"ns_min\": %.3f, "
+			"\"rhs_per_step\": %.4f, \"steps\": %zu, \"accepted\": %zu, \"rejected\": %zu, \"allocs_per_step\": %.4f }%s\n",
+			json_string(cases[k].name).c_str(), json_string(cases[k].kernel).c_str(), json_string(cases[k].rhs).c_str(), cases[k].e,
+			r.ns_per_step, r.ns_min, r.rhs_per_step, r.run.steps, r.run.accepted, r.run.rejected, r.allocs_per_step,
+			k + 1 < cases.size() ? "," : "");
+	}
+	std::fprintf(file, "  ]\n}\n");
+	return std::fclose(file) == 0;
+}
+
+static void usage() {
+	std::cerr <<
+		"usage: RK_4_bench [options]\n"
+		"  --filter TEXT     run only benchmarks whose name contains TEXT\n"
+		"  --min-time S      seconds per repeat (default 0.05)\n"
+		"  --repeats N       repeats, the median is reported (default 5)\n"
+		"  --json FILE       also write the results as JSON\n";
+}
+
+int main(int argc, char** argv) {
+	std::string filter, json;
+	double min_time = 0.05;
+	int repeats = 5;
+	try {
+		for (int k = 1; k < argc; k++) {
+			std::string name = argv[k];
+			if (k + 1 >= argc)
+				throw std::invalid_argument("missing value for " + name);
+			const char* value = argv[++k];
+			if (name == "--filter") filter = value;
+			else if (name == "--min-time") min_time = std::stod(value);
+			else if (name == "--repeats") repeats = std::stoi(value);
+			else if (name == "--json") json = value;
+			else throw std::invalid_argument("unknown option " + name);
+		}
+		if (repeats < 1 || !(min_time >= 0))
+			throw std::invalid_argument("--repeats must be positive and --min-time non-negative");
+	}
+	catch (const std::exception& ex) {
+		std::cerr << "RK_4_bench: " << ex.what() << "\n";
+		usage();
+		return 1;
+	}
+
+	std::vector<Bench_case> cases;
+	for (Bench_case& bench : bench_cases())
+		if (bench.name.find(filter) != std::string::npos)
+			cases.push_back(std::move(bench));
+	int width = 50;
+	for (const Bench_case& bench : cases)
+		width = std::max(width, (int)bench.name.size());
+	std::vector<Bench_result> results;
+	std::printf("%-*s %12s %10s %10s %10s %12s\n", width, "benchmark", "ns/step", "rhs/step", "accepted", "rejected", "allocs/step");
+	for (const Bench_case& bench : cases) {
+		results.push_back(measure(bench, min_time, repeats));
+		const Bench_result& r = results.back();
+		std::printf("%-*s %12.2f %10.3f %10zu %10zu %12.4f\n", width, bench.name.c_str(), r.ns_per_step, r.rhs_per_step,
+			r.run.accepted, r.run.rejected, r.allocs_per_step);
+		std::fflush(stdout);
+	}
+	if (!json.empty() && !write_json(json, cases, results, min_time, repeats)) {
+		std::cerr << "RK_4_bench: cannot write " << json << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,506 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "RK_4_tasks.h"
+#include "RK_decimate.h"
+#include "RK_sweep.h"
+#include "RK_trajectory_file.h"
+
+/*
+*	RK_4_cli -      
+*	RK_4_cli <1-7> [--xmin 0] [--xmax 1] [--h 0.1] [--border 0.01] [--e 1e-5] [--u0 1]
+*	               [--u0_1 1] [--u0_2 1] [--a 1] [--b 1] [--max-steps 1000] [--method rk4]
+*	               [--scheme rk4] [--control halving] [--precompute] [--save-step 0.01 | --save-at x1,x2,...]
+*	               [--table] [--decimate none|minmax|lttb] [--width 501] [--trajectory file.rktraj [--compress]]
+*	               [--rhs "; ..." [--rhs-listing] [--rhs-native]]
+*	RK_4_cli read file.rktraj -       
+*	      
+*	RK_4_cli sweep [--a-min 0] [--a-max 1] [--a-count 11] [--b-min 0] [--b-max 1] [--b-count 11]
+*	               [--ic u0_1:u0_2,...] [--threads 0] [--out sweep.csv] [ ]
+*	  2       (a, b)
+*	RK_4_cli ensemble <5|6> [--members 10000] [--spread 0.1] [--compare] [ ]
+*	 5  6   members  (RK_4_ensemble),  --compare -    
+*/
+static void usage() {
+	std::cerr <<
+		"usage: RK_4_cli <task 1-7> [options]\n"
+		"  1 - test problem, fixed step        3 - test problem, adaptive step\n"
+		"  5 - problem 1, fixed step           4 - problem 1, adaptive step\n"
+		"  6 - problem 2, fixed step           7 - problem 2, adaptive step\n"
+		"  2 - problem 2, phase portrait\n"
+		"       RK_4_cli sweep [options] - task 7 over a grid of (a, b), written to a CSV file\n"
+		"       RK_4_cli read FILE       - header and column ranges of a binary trajectory file\n"
+		"       RK_4_cli ensemble <5|6> [options] - the fixed-step task for many initial values at once\n"
+		"options:\n"
+		"  --xmin X --xmax X --h H --border B --e E --u0 U\n"
+		"  --u0_1 U --u0_2 U --a A --b B --max-steps N\n"
+		"  --method rk4|bs32|dp54|dop853   step size control of tasks 2, 3, 4, 7\n"
+		"  --method ros3|sdirk4            implicit methods for stiff right-hand sides (same tasks)\n"
+		"  --method auto                   dp54, switching to ros3 while the problem is stiff\n"
+		"  --method abm                    Adams-Bashforth-Moulton PECE, variable step and order up to 12\n"
+		"  --method gbs                    Gragg-Bulirsch-Stoer extrapolation, variable order (tight tolerances)\n"
+		"  --scheme rk4|rk38|ralston|heun  Runge-Kutta scheme of the fixed-step tasks 1, 5, 6\n"
+		"  --rhs EXPR                      tasks 4, 5: right-hand side f(x, v) as an expression\n"
+		"  --rhs EXPR1;EXPR2               tasks 2, 6, 7, sweep: dv1, dv2 in x, v1, v2 and the parameters a, b\n"
+		"  --rhs-listing                   print the compiled bytecode of --rhs\n"
+		"  --rhs-native                    compile --rhs to machine code with the system C++ compiler\n"
+		"                                  (cached in RK_4_CACHE or ~/.cache/rk_4, compiler RK_4_CXX or CXX)\n"
+		"  --control halving|pi|pid        how the step size is changed\n"
+		"  --h auto                        choose the initial step automatically\n"
+		"  --precompute                    task 5: evaluate the x-only terms of f once per grid point, in blocks\n"
+		"  --save-step D                   tasks 3, 4, 7: table rows on the uniform grid xmin, xmin + D, ..., xmax\n"
+		"  --save-at X1,X2,...             tasks 3, 4, 7: table rows at the given increasing points\n"
+		"  --table   print every table row as CSV before the summary\n"
+		"  --decimate none|minmax|lttb     --table prints only the rows a plot of --width pixels shows\n"
+		"  --width W                       plot width in pixels for --decimate (default 501)\n"
+		"  --trajectory FILE               stream every table row to a binary trajectory file\n"
+		"  --compress                      --trajectory: compress the columns (lossless XOR/RLE)\n"
+		"sweep options:\n"
+		"  --a-min A --a-max A --a-count N --b-min B --b-max B --b-count N\n"
+		"  --ic U1:U2,U1:U2,...            initial conditions (default --u0_1, --u0_2)\n"
+		"  --threads N                     worker threads (default: all cores)\n"
+		"  --out FILE                      output CSV (default sweep.csv)\n"
+		"ensemble options:\n"
+		"  --members N                     number of trajectories (default 10000)\n"
+		"  --spread S                      member m starts at u0 + S m / N (task 6: u0_1; default 0.1)\n"
+		"  --compare                       also run every member through task 5 or 6 and compare the time and values\n";
+}
+
+/*
+*	 parse_grid -  x1,x2,...  
+*/
+static std::vector<double> parse_grid(const std::string& value) {
+	std::vector<double> grid;
+	std::size_t start = 0;
+	while (start <= value.size()) {
+		std::size_t end = value.find(',', start);
+		if (end == std::string::npos)
+			end = value.size();
+		grid.push_back(std::stod(value.substr(start, end - start)));
+		if (grid.size() > 1 && grid[grid.size() - 1] <= grid[grid.size() - 2])
+			throw std::invalid_argument("--save-at points must increase");
+		start = end + 1;
+	}
+	return grid;
+}
+
+/*
+*	 parse_initial -   u0_1:u0_2  
+*/
+static std::vector<std::pair<double, double>> parse_initial(const std::string& value) {
+	std::vector<std::pair<double, double>> initial;
+	std::size_t start = 0;
+	while (start <= value.size()) {
+		std::size_t end = value.find(',', start);
+		if (end == std::string::npos)
+			end = value.size();
+		std::string item = value.substr(start, end - start);
+		std::size_t colon = item.find(':');
+		if (colon == std::string::npos)
+			throw std::invalid_argument("--ic expects u0_1:u0_2 pairs");
+		initial.push_back({ std::stod(item.substr(0, colon)), std::stod(item.substr(colon + 1)) });
+		start = end + 1;
+	}
+	return initial;
+}
+
+static void print_table(const Task_result& result, Decimation decimation, std::size_t width) {
+	std::printf("i,x,v,v_2h,v-v_2h,OLP,h,C1,C2");
+	if (result.has_true_solution)
+		std::printf(",u,u-v");
+	if (result.is_system)
+		std::printf(",v2,v2_2h");
+	std::printf("\n");
+	const Trajectory& rows = result.rows;
+	for (std::size_t k : decimate(rows.x.data(), rows.v.data(), rows.size(), decimation, width)) {
+		std::printf("%zu,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%zu,%zu", rows.i[k], rows.x[k], rows.v[k], rows.v_2h[k], rows.v_v_2h[k], rows.OLP[k], rows.h[k], rows.C1[k], rows.C2[k]);
+		if (rows.has_true_solution())
+			std::printf(",%.17g,%.17g", rows.u[k], rows.u_v[k]);
+		if (rows.is_system())
+			std::printf(",%.17g,%.17g", rows.v2[k], rows.v2_2h[k]);
+		std::printf("\n");
+	}
+}
+
+/*
+*	 print_distribution -           
+*/
+static void print_distribution(const Step_stats& stats) {
+	std::printf("OLP mean = %.17g, std = %.17g over %zu steps\n", stats.OLP.mean, std::sqrt(stats.OLP.variance()), stats.OLP.count);
+	std::printf("h histogram:");
+	for (int bin = 0; bin < Log2_histogram::Bins; bin++)
+		if (stats.h.counts[bin] != 0)
+			std::printf(" [2^%d, 2^%d): %zu", Log2_histogram::exponent(bin), Log2_histogram::exponent(bin) + 1, stats.h.counts[bin]);
+	std::printf("\n");
+}
+
+/*
+*	 print_counters -   (  RK_4_COUNTERS)
+*/
+static void print_counters(const Solver_counters& counters) {
+	std::printf("counters: RHS calls = %zu, attempted = %zu, accepted = %zu, rejected = %zu\n",
+		counters.rhs_calls, counters.attempted, counters.accepted, counters.rejected);
+	std::printf("counters: step decreases = %zu, increases = %zu, clamped to xmax = %zu\n",
+		counters.decreases, counters.increases, counters.endpoint_clamps);
+	std::printf("counters: time %.6f s:", counters.total_seconds());
+	for (int k = 0; k < (int)Phase::Count; k++)
+		std::printf(" %s %.6f", phase_name((Phase)k), counters.seconds[k]);
+	std::printf("\n");
+}
+
+static void print_summary(const Task_result& result) {
+	if (result.failed)
+		std::printf("step failed: the error estimate stays above e (inf or nan) down to the smallest step\n");
+	std::printf("n = %zu\n", result.n);
+	std::printf("b - x_n = %.17g\n", result.b_x_n);
+	const Step_stats& stats = result.stats;
+	std::printf("max|OLP| = %.17g at x = %.17g\n", stats.max_OLP.value, stats.max_OLP.x);
+	std::printf("max h = %.17g at x = %.17g\n", stats.max_h.value, stats.max_h.x);
+	std::printf("min h = %.17g at x = %.17g\n", stats.min_h.value, stats.min_h.x);
+	std::printf("step increases = %zu\n", stats.C2_amount);
+	std::printf("step decreases = %zu\n", stats.C1_amount);
+	std::printf("max|u_i-v_i| = %.17g at x = %.17g\n", stats.max_u_v.value, stats.max_u_v.x);
+	print_distribution(stats);
+	std::printf("RHS evaluations = %zu\n", result.rhs_calls);
+	std::size_t trials = result.accepted_steps + result.rejected_steps;
+	std::printf("rejected steps = %zu of %zu (%.2f%%)\n", result.rejected_steps, trials, trials == 0 ? 0.0 : 100.0 * result.rejected_steps / trials);
+	if (result.jacobians != 0)
+		std::printf("jacobians = %zu, LU factorizations = %zu\n", result.jacobians, result.factorizations);
+	if (result.explicit_steps + result.implicit_steps != 0)
+		std::printf("explicit steps = %zu, implicit steps = %zu, method switches = %zu\n",
+			result.explicit_steps, result.implicit_steps, result.method_switches);
+	if (Counters_enabled)
+		print_counters(result.counters);
+}
+
+/*
+*	 read_trajectory -          
+*/
+static int read_trajectory(const std::string& path) {
+	Trajectory_file file;
+	if (!file.open(path)) {
+		std::cerr << "RK_4_cli: " << file.error() << "\n";
+		return 1;
+	}
+	const Trajectory_header& header = file.header();
+	std::printf("task = %d\n", header.task);
+	std::printf("method = %s, control = %s\n", method_name(header.method), control_name(header.control));
+	std::printf("xmin = %.17g, xmax = %.17g, h0 = %.17g, e = %.17g\n", header.xmin, header.xmax, header.h0, header.e);
+	std::printf("u0 = %.17g, u0_1 = %.17g, u0_2 = %.17g, a = %.17g, b = %.17g\n", header.u0, header.u0_1, header.u0_2, header.a, header.b);
+	std::printf("rows = %zu in %zu chunks%s\n", file.rows(), file.chunks(), header.version == 2 ? ", compressed" : "");
+	std::vector<double> decoded;
+	std::vector<std::uint64_t> decoded_counts;
+	for (std::size_t j = 0; j < header.columns.size(); j++) {
+		double min = 0, max = 0;
+		for (std::size_t k = 0; k < file.chunks(); k++) {
+			const double* values = file.f64((int)j, k);
+			const std::uint64_t* counts = file.u64((int)j, k);
+			if (values == nullptr && counts == nullptr) {
+				//  
+				bool ok = header.columns[j].type == Column_type::F64 ? file.read_f64((int)j, k, decoded) : file.read_u64((int)j, k, decoded_counts);
+				if (!ok) {
+					std::cerr << "RK_4_cli: corrupt column " << header.columns[j].name << "\n";
+					return 1;
+				}
+				values = header.columns[j].type == Column_type::F64 ? decoded.data() : nullptr;
+				counts = decoded_counts.data();
+			}
+			for (std::size_t r = 0; r < file.chunk_size(k); r++) {
+				double value = values != nullptr ? values[r] : (double)counts[r];
+				if ((k == 0 && r == 0) || value < min) min = value;
+				if ((k == 0 && r == 0) || value > max) max = value;
+			}
+		}
+		std::printf("%-8s min = %.17g, max = %.17g\n", header.columns[j].name.c_str(), min, max);
+	}
+	return 0;
+}
+
+/*
+*	 run_ensemble -  5  6  members     u0 + spread m / members
+*	(  6 - u0_1)   (run_task1_ensemble, run_task2_ensemble)
+*	            v ( inf  nan);
+*	 compare -         (run_task1_fixed, run_task2_fixed,
+*	      )   ,         
+*/
+static int run_ensemble(int button, const Task_params& params, std::size_t members, double spread, bool compare) {
+	typedef std::chrono::steady_clock clock;
+	std::vector<Task2_member> system(button == 6 ? members : 0);
+	std::vector<double> u0(button == 5 ? members : 0);
+	for (std::size_t m = 0; m < members; m++) {
+		double shift = spread * m / members;
+		if (button == 5)
+			u0[m] = params.u0 + shift;
+		else
+			system[m] = { params.u0_1 + shift, params.u0_2, params.a, params.b };
+	}
+
+	std::size_t steps = 0;
+	std::vector<double> v1(members), v2(members);
+	clock::time_point start = clock::now();
+	if (button == 5)
+		v1 = run_task1_ensemble(params, u0, &steps);
+	else {
+		std::vector<State<2>> v = run_task2_ensemble(params, system, &steps);
+		for (std::size_t m = 0; m < members; m++) {
+			v1[m] = v[m][0];
+			v2[m] = v[m][1];
+		}
+	}
+	double seconds = std::chrono::duration<double>(clock::now() - start).count();
+	const double member_steps = (double)members * (steps == 0 ? 1 : steps);
+	std::printf("members = %zu\n", members);
+	std::printf("steps = %zu per member\n", steps);
+	double min = INFINITY, max = -INFINITY;
+	std::size_t finite = 0;
+	for (double v : v1)
+		if (std::isfinite(v)) {
+			min = std::min(min, v);
+			max = std::max(max, v);
+			finite++;
+		}
+	std::printf("min v = %.17g, max v = %.17g over %zu finite members\n", min, max, finite);
+	std::printf("ensemble: %.6f s, %.3f ns per member-step\n", seconds, seconds * 1e9 / member_steps);
+	if (!compare)
+		return 0;
+
+	std::size_t different = 0;
+	start = clock::now();
+	for (std::size_t m = 0; m < members; m++) {
+		Task_params member = params;
+		if (button == 5)
+			member.u0 = u0[m];
+		else
+			member.u0_1 = system[m].u0_1;
+		Task_result result = run_task(button, member, false);
+		bool same = std::memcmp(&result.v_n, &v1[m], sizeof(double)) == 0;
+		if (button == 6)
+			same = same && std::memcmp(&result.v2_n, &v2[m], sizeof(double)) == 0;
+		if (!same)
+			different++;
+	}
+	double scalar_seconds = std::chrono::duration<double>(clock::now() - start).count();
+	std::printf("scalar: %.6f s, %.3f ns per member-step (%.2fx the ensemble)\n", scalar_seconds, scalar_seconds * 1e9 / member_steps,
+		seconds > 0 ? scalar_seconds / seconds : 0.0);
+	std::printf("members with different final values = %zu\n", different);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		usage();
+		return 1;
+	}
+	if (std::string(argv[1]) == "read") {
+		if (argc != 3) {
+			usage();
+			return 1;
+		}
+		return read_trajectory(argv[2]);
+	}
+	Task_params params;
+	Sweep_params sweep;
+	std::string out = "sweep.csv";
+	bool table = false;
+	Decimation decimation = Decimation::None;
+	std::size_t width = 501;
+	std::string trajectory;
+	bool compress = false;
+	std::string rhs_text;
+	bool listing = false;
+	bool native = false;
+	bool is_sweep = std::string(argv[1]) == "sweep";
+	bool is_ensemble = std::string(argv[1]) == "ensemble";
+	std::size_t members = 10000;
+	double spread = 0.1;
+	bool compare = false;
+	int button = 0;
+	double save_step = 0;
+	try {
+		int first = 2;
+		if (is_ensemble) {
+			if (argc < 3)
+				throw std::invalid_argument("ensemble needs a task number (5 or 6)");
+			button = std::stoi(argv[2]);
+			first = 3;
+		}
+		else if (!is_sweep)
+			button = std::stoi(argv[1]);
+		for (int k = first; k < argc; k++) {
+			std::string name = argv[k];
+			if (name == "--table") {
+				table = true;
+				continue;
+			}
+			if (name == "--compress") {
+				compress = true;
+				continue;
+			}
+			if (name == "--rhs-listing") {
+				listing = true;
+				continue;
+			}
+			if (name == "--precompute") {
+				params.precompute = true;
+				continue;
+			}
+			if (name == "--rhs-native") {
+				native = true;
+				continue;
+			}
+			if (is_ensemble && name == "--compare") {
+				compare = true;
+				continue;
+			}
+			if (k + 1 >= argc)
+				throw std::invalid_argument("missing value for " + name);
+			const char* value = argv[++k];
+			if (name == "--xmin") params.xmin = std::stod(value);
+			else if (name == "--xmax") params.xmax = std::stod(value);
+			else if (name == "--h" && std::string(value) == "auto") params.auto_h = true;
+			else if (name == "--h") params.h = std::stod(value);
+			else if (name == "--border") params.border = std::stod(value);
+			else if (name == "--e") params.e = std::stod(value);
+			else if (name == "--u0") params.u0 = std::stod(value);
+			else if (name == "--u0_1") params.u0_1 = std::stod(value);
+			else if (name == "--u0_2") params.u0_2 = std::stod(value);
+			else if (name == "--a") params.a = std::stod(value);
+			else if (name == "--b") params.b = std::stod(value);
+			else if (name == "--max-steps") params.Max_steps = std::stoull(value);
+			else if (name == "--save-step") save_step = std::stod(value);
+			else if (name == "--save-at") params.save_at = parse_grid(value);
+			else if (name == "--decimate") {
+				if (!parse_decimation(value, decimation))
+					throw std::invalid_argument(std::string("unknown decimation ") + value);
+			}
+			else if (name == "--width") width = std::stoull(value);
+			else if (name == "--trajectory") trajectory = value;
+			else if (name == "--rhs") rhs_text = value;
+			else if (is_sweep && name == "--a-min") sweep.a_min = std::stod(value);
+			else if (is_sweep && name == "--a-max") sweep.a_max = std::stod(value);
+			else if (is_sweep && name == "--a-count") sweep.a_count = std::stoull(value);
+			else if (is_sweep && name == "--b-min") sweep.b_min = std::stod(value);
+			else if (is_sweep && name == "--b-max") sweep.b_max = std::stod(value);
+			else if (is_sweep && name == "--b-count") sweep.b_count = std::stoull(value);
+			else if (is_sweep && name == "--ic") sweep.initial = parse_initial(value);
+			else if (is_sweep && name == "--threads") sweep.threads = static_cast<unsigned>(std::stoul(value));
+			else if (is_sweep && name == "--out") out = value;
+			else if (is_ensemble && name == "--members") members = std::stoull(value);
+			else if (is_ensemble && name == "--spread") spread = std::stod(value);
+			else if (name == "--method") {
+				if (!parse_method(value, params.method))
+					throw std::invalid_argument(std::string("unknown method ") + value);
+			}
+			else if (name == "--scheme") {
+				if (!parse_scheme(value, params.scheme))
+					throw std::invalid_argument(std::string("unknown scheme ") + value);
+			}
+			else if (name == "--control") {
+				if (!parse_control(value, params.control))
+					throw std::invalid_argument(std::string("unknown control ") + value);
+			}
+			else throw std::invalid_argument("unknown option " + name);
+		}
+	}
+	catch (const std::exception& ex) {
+		std::cerr << "RK_4_cli: " << ex.what() << "\n";
+		usage();
+		return 1;
+	}
+	Rhs_program program;
+	Native_rhs_library library;
+	if (!rhs_text.empty()) {
+		if (!is_sweep && (button == 1 || button == 3)) {
+			std::cerr << "RK_4_cli: --rhs does not apply to the test problem (tasks 1, 3)\n";
+			return 1;
+		}
+		std::size_t dimension = (button == 4 || button == 5) ? 1 : 2;
+		if (!program.compile(split_expressions(rhs_text), { "a", "b" })) {
+			std::cerr << "RK_4_cli: --rhs: " << program.error() << "\n";
+			return 1;
+		}
+		if (program.dimension() != dimension) {
+			std::cerr << "RK_4_cli: --rhs: the task needs " << dimension << " expression(s) separated by ';'\n";
+			return 1;
+		}
+		if (listing)
+			std::printf("%s", program.listing().c_str());
+		params.rhs = &program;
+		if (native) {
+			if (!library.load(program)) {
+				std::cerr << "RK_4_cli: --rhs-native: " << library.error() << "\n";
+				return 1;
+			}
+			std::cerr << "RK_4_cli: --rhs-native: " << library.path() << (library.cached() ? " (cached)\n" : " (compiled)\n");
+			params.native = &library;
+		}
+	}
+	if (is_sweep) {
+		if (sweep.a_count == 0 || sweep.b_count == 0) {
+			usage();
+			return 1;
+		}
+		sweep.task = params;
+		Step_stats total;
+		std::vector<Sweep_cell> cells = run_sweep(sweep, &total);
+		if (!write_sweep(out, cells)) {
+			std::cerr << "RK_4_cli: cannot write " << out << "\n";
+			return 1;
+		}
+		std::size_t rhs_calls = 0;
+		for (const Sweep_cell& cell : cells)
+			rhs_calls += cell.rhs_calls;
+		std::printf("cells = %zu\n", cells.size());
+		std::printf("steps = %zu\n", total.steps);
+		std::printf("max|OLP| = %.17g, min h = %.17g, max h = %.17g\n", total.max_OLP.value, total.min_h.value, total.max_h.value);
+		print_distribution(total);
+		std::printf("RHS evaluations = %zu\n", rhs_calls);
+		return 0;
+	}
+	if (is_ensemble) {
+		if ((button != 5 && button != 6) || members == 0) {
+			usage();
+			return 1;
+		}
+		return run_ensemble(button, params, members, spread, compare);
+	}
+	if (button < 1 || button > 7) {
+		usage();
+		return 1;
+	}
+	if (save_step > 0)
+		params.save_at = uniform_grid(params.xmin, params.xmax, save_step);
+
+	Trajectory_writer writer;
+	if (!trajectory.empty() && table) {
+		//            
+		std::cerr << "RK_4_cli: --table and --trajectory cannot be combined\n";
+		return 1;
+	}
+	if (!trajectory.empty()) {
+		if (!writer.open(trajectory, button, params, Trajectory_chunk_rows, compress)) {
+			std::cerr << "RK_4_cli: cannot write " << trajectory << "\n";
+			return 1;
+		}
+		params.output = &writer;
+	}
+	Task_result result = run_task(button, params, table || !trajectory.empty());
+	if (!trajectory.empty() && (!writer.close() || result.output_failed)) {
+		std::cerr << "RK_4_cli: cannot write " << trajectory << "\n";
+		return 1;
+	}
+	if (table)
+		print_table(result, decimation, width);
+	print_summary(result);
+	if (result.failed) {
+		std::cerr << "RK_4_cli: no step accepted at x = " << params.xmax - result.b_x_n << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RK_counters.h"
+
+/*
+*	System_rhs -        n
+*	double x -    
+*	const double* v -  v1 ... vn   
+*	double* dv -  dv1 ... dvn
+*	const double* coeffs -   (  2 - { a, b })
+*/
+typedef void(*System_rhs)(double x, const double* v, double* dv, const double* coeffs);
+
+/*
+*	Dynamic -  ,    
+*	State<N> -   : std::array    N, std::vector  N = Dynamic
+*/
+const std::size_t Dynamic = 0;
+
+template <std::size_t N>
+using State = typename std::conditional<N == Dynamic, std::vector<double>, std::array<double, N>>::type;
+
+/*
+*	 make_state -    n,  
+*	( N != Dynamic  n )
+*/
+template <std::size_t N>
+State<N> make_state(std::size_t n) {
+	State<N> v{};
+	if constexpr (N == Dynamic)
+		v.assign(n, 0.0);
+	(void)n;
+	return v;
+}
+
+/*
+*	Scalar_rhs, System_call -      f(x, v, dv)   ,   
+*	Scalar_rhs<F> -   f(x, v)    F (, ,    ),
+*	Scalar_call -       double(*f)(double, double)
+*	System_call -  System_rhs  
+*	,   Scalar_rhs        ,
+*	       
+*/
+template <class F>
+struct Scalar_rhs {
+	F f;
+	void operator()(double x, const double* v, double* dv) const {
+		dv[0] = f(x, v[0]);
+	}
+
+	//   1 x 1,    F (RK_stiff.h)
+	template <class G = F>
+	auto jacobian(double x, const double* v, double* J, double* dfdx) const -> decltype(std::declval<const G&>().jacobian(x, v[0], J, dfdx)) {
+		return f.jacobian(x, v[0], J, dfdx);
+	}
+};
+
+typedef Scalar_rhs<double(*)(double, double)> Scalar_call;
+
+struct System_call {
+	System_rhs f;
+	const double* coeffs;
+	void operator()(double x, const double* v, double* dv) const {
+		f(x, v, dv, coeffs);
+	}
+};
@@ -0,0 +1,772 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "RK_4_tasks.h"
+#include "RK_adams.h"
+#include "RK_extrapolation.h"
+#include "RK_split.h"
+#include "RK_stiff.h"
+#include "RK_switch.h"
+#include "RK_trajectory_file.h"
+
+/*
+*	 add_row -        (Step_stats)
+*/
+static void add_row(Task_result& result, const Table_row& row, bool keep_rows) {
+	RK_PHASE(Phase::Output);
+	result.stats.add(row, result.has_true_solution);
+	if (keep_rows)
+		result.rows.push_back(row);
+}
+
+/*
+*	 prepare_rows -      rows  (  Max_steps),
+*	      
+*/
+static void prepare_rows(Task_result& result, const Task_params& params, double rows, bool keep_rows) {
+	result.rows.set_columns(result.has_true_solution, result.is_system);
+	if (params.output != nullptr && keep_rows) {
+		result.rows.attach(params.output);
+		rows = std::fmin(rows, (double)params.output->chunk_rows());
+	}
+	if (keep_rows)
+		result.rows.reserve(static_cast<std::size_t>(std::fmax(1.0, std::fmin(rows, (double)params.Max_steps))));
+}
+
+/*
+*	 adaptive_rows -        
+*	(   ,    save_at -   4096,   )
+*/
+static double adaptive_rows(const Task_params& params) {
+	return params.save_at.empty() ? 4096.0 : params.save_at.size() + 1.0;
+}
+
+/*
+*	 OLP_factor - ,   |v - v_2h|    :
+*	2^p     , 1    (|v - v_2h| -    )
+*/
+static double OLP_factor(Method method) {
+	return method == Method::RK4 ? pow(2, p) : 1.0;
+}
+
+/*
+*	S_divisor, OLP_scale -  S()   2^q    q = Tableau::order,
+*	  ,     
+*	( = |v - v_2h| / (2^q - 1) * 2^q,  ,  S(v, v_2h, q) * pow(2, q))
+*/
+template <class Tableau>
+constexpr double OLP_scale = double(1ull << Tableau::order);
+
+template <class Tableau>
+constexpr double S_divisor = OLP_scale<Tableau> - 1;
+
+/*
+*	 error_order -      (   )
+*/
+static int error_order(Method method) {
+	if (is_stiff(method))
+		return stiff_error_order(method);
+	return method == Method::RK4 || method == Method::ABM || method == Method::GBS ? p : embedded_tableau(method).error_order;
+}
+
+/*
+*	 implicit_method -   : ROS3      (AUTO),   
+*/
+static Method implicit_method(Method method) {
+	return method == Method::AUTO ? Method::ROS3 : method;
+}
+
+/*
+*	 first_row -      
+*/
+static Table_row first_row(double xmin, double u0, bool has_true_solution) {
+	Table_row row;
+	row.x = xmin;
+	row.v = u0;
+	if (has_true_solution)
+		row.u = u0;
+	return row;
+}
+
+/*
+*	 check_rhs -    params.rhs   dimension
+*/
+static void check_rhs(const Task_params& params, std::size_t dimension) {
+	if (params.rhs->dimension() != dimension)
+		throw std::invalid_argument("the task needs " + std::to_string(dimension) + " right-hand side expression(s), got " +
+			std::to_string(params.rhs->dimension()));
+	if (params.rhs->parameter_count() > 2)
+		throw std::invalid_argument("right-hand side expressions may only use the parameters a and b");
+}
+
+/*
+*	 program_registers -   params.rhs   { a, b } (lanes   )
+*/
+static std::vector<double> program_registers(const Task_params& params, std::size_t dimension, std::size_t lanes = 1) {
+	check_rhs(params, dimension);
+	const double coeffs[2] = { params.a, params.b };
+	return params.rhs->registers(coeffs, lanes);
+}
+
+/*
+*	 first_save_point -     save_at,   xmin
+*/
+static std::size_t first_save_point(const Task_params& params) {
+	std::size_t next = 0;
+	while (next < params.save_at.size() && params.save_at[next] < params.xmin)
+		next++;
+	return next;
+}
+
+/*
+*	 save_points -   save_at,     [x0, x1]
+*	     :     RK4  GBS,
+*	     BS32, DP54, DOP853,    Stiff_stepper  ROS3, SDIRK4,
+*	   Adams_stepper  ABM;
+*	     rhs_calls
+*	std::size_t& next -       
+*	Emit emit - emit(k, x, v)    , x   v  
+*/
+template <std::size_t N, class F, class Stepper, class Emit>
+static void save_points(const Task_params& params, std::size_t& next, Hermite_dense<N, F>& hermite, Stepper& stepper,
+	double x0, const State<N>& v0, double x1, const State<N>& v1, std::size_t& rhs_calls, Emit emit) {
+	const std::vector<double>& grid = params.save_at;
+	if (next >= grid.size() || grid[next] > x1)
+		return;
+	RK_PHASE(Phase::Output);
+	std::size_t calls = hermite.rhs_calls + stepper.rhs_calls;
+	if (params.method == Method::RK4)
+		hermite.set_step(x0, x1 - x0, v0, v1);
+	State<N> v = make_state<N>(v0.size());
+	for (; next < grid.size() && grid[next] <= x1; next++) {
+		double t = (grid[next] - x0) / (x1 - x0);
+		if (params.method == Method::RK4)
+			hermite.dense(t, v);
+		else
+			stepper.dense(t, v);
+		emit(next, grid[next], v);
+	}
+	rhs_calls += hermite.rhs_calls + stepper.rhs_calls - calls;
+}
+
+/*
+*	 integrating -          x:
+*	  save_at -  x      xmax,   -       xmax
+*/
+static bool integrating(const Task_params& params, double x, std::size_t next) {
+	if (params.save_at.empty())
+		return x < params.xmax - params.border;
+	return x < params.xmax && next < params.save_at.size() && params.save_at[next] <= params.xmax;
+}
+
+/*
+*	 with_rhs -  run(f)    :  params.rhs (Native_rhs,  
+*	  params.native,  Program_rhs     ;  - a, b)
+*	   builtin (Function_1, Function_2)
+*	std::size_t dimension -   ,   params.rhs    
+*/
+template <class Builtin, class Run>
+static Task_result with_rhs(const Task_params& params, std::size_t dimension, Builtin builtin, Run run) {
+	if (params.rhs == nullptr)
+		return run(builtin);
+	if (params.native != nullptr) {
+		check_rhs(params, dimension);
+		const double coeffs[2] = { params.a, params.b };
+		return run(Native_rhs{ params.native->function(), coeffs });
+	}
+	std::vector<double> registers = program_registers(params, dimension);
+	return run(Program_rhs{ params.rhs, registers.data() });
+}
+
+/*
+*	 run_scalar_fixed -           1
+*	    Tableau (params.scheme)
+*	F f -   f(x, v)    (Test_function, Function_1),    
+*	    (Function_1)  params.precompute ,    x,
+*	     Split_block  (Coefficient_table)     
+*/
+template <class Tableau, class F>
+static Task_result run_scalar_fixed(F f, const Task_params& params, bool has_true_solution, bool keep_rows) {
+	RK_PHASE(Phase::Other);
+	const Solver_counters counters_start = counters_snapshot();
+	Task_result result;
+	result.has_true_solution = has_true_solution;
+	prepare_rows(result, params, (params.xmax - params.xmin) / params.h + 2, keep_rows);
+	double h = params.h;
+	double v = params.u0;
+	double v_last = params.u0;
+	if (keep_rows)
+		result.rows.push_back(first_row(params.xmin, params.u0, has_true_solution));
+
+	std::size_t i = 1;
+	double x = params.xmin + h;
+	std::conditional_t<is_split_rhs<F>::value, Coefficient_table<F>, int> table{};
+	std::size_t block_end = i;
+
+	for (; (x <= params.xmax) && (i < params.Max_steps); x += h)
+	{
+		v_last = v;
+		Step_doubling new_point;
+		if constexpr (is_split_rhs<F>::value) {
+			if (params.precompute) {
+				if (i == block_end) {
+					table.template fill_step_doubling<Tableau>(x, h, params.xmax, std::min(Split_block, params.Max_steps - i));
+					block_end = i + Split_block;
+				}
+				new_point = explicit_step_doubling<Tableau>(Split_rhs<F>{ f, &table }, h, x, v_last);
+			}
+			else
+				new_point = explicit_step_doubling<Tableau>(f, h, x, v_last);
+		}
+		else
+			new_point = explicit_step_doubling<Tableau>(f, h, x, v_last);
+		v = new_point.v_h;
+		result.rhs_calls += new_point.rhs_calls;
+
+		Table_row row;
+		row.i = i;
+		row.x = x;
+		row.v = v;
+		row.v_2h = new_point.v_2h;
+		row.v_v_2h = std::abs(v - row.v_2h);
+		row.OLP = row.v_v_2h / S_divisor<Tableau> * OLP_scale<Tableau>;
+		row.h = h;
+		if (has_true_solution) {
+			row.u = floor(true_trajectory(x, params.u0) * 10000) / 10000;
+			row.u_v = std::abs(row.u - v);
+		}
+		add_row(result, row, keep_rows);
+		i++;
+	}
+	result.n = i;
+	result.b_x_n = params.xmax - x + h;
+	result.v_n = v;
+	result.output_failed = !result.rows.flush();
+	result.counters = counters_snapshot() - counters_start;
+	return result;
+}
+
+/*
+*	 run_scalar_adaptive -           1
+*/
+template <class F>
+static Task_result run_scalar_adaptive(F f, const Task_params& params, bool has_true_solution, bool keep_rows) {
+	RK_PHASE(Phase::Other);
+	const Solver_counters counters_start = counters_snapshot();
+	Task_result result;
+	result.has_true_solution = has_true_solution;
+	prepare_rows(result, params, adaptive_rows(params), keep_rows);
+	double h = params.h;
+	double v = params.u0;
+	double x = params.xmin;
+	double last_x = params.xmin;
+	OLP_step<1> new_point;
+	Embedded_stepper<1, Scalar_rhs<F>> stepper(params.method, Scalar_rhs<F>{ f });
+	Stiff_stepper<1, Scalar_rhs<F>> stiff(implicit_method(params.method), Scalar_rhs<F>{ f });
+	stiff.tolerance = params.e;
+	Switching_stepper<decltype(stepper), decltype(stiff)> switching(stepper, stiff);
+	Adams_stepper<1, Scalar_rhs<F>> adams(Scalar_rhs<F>{ f });
+	Extrapolation_stepper<1, Scalar_rhs<F>> gbs(Scalar_rhs<F>{ f });
+	gbs.tolerance = params.e;
+	Hermite_dense<1, Scalar_rhs<F>> hermite(Scalar_rhs<F>{ f });
+	Step_controller controller;
+	controller.type = params.control;
+	auto OLP = [&](double x0, double u0, double h0) {
+		if (params.method == Method::RK4)
+			return RK_4_OLP(f, x0, u0, h0, params.e, &controller);
+		if (params.method == Method::AUTO)
+			return RK_embedded_OLP(switching, x0, State<1>{ u0 }, h0, params.e, &controller);
+		if (params.method == Method::ABM)
+			return RK_embedded_OLP(adams, x0, State<1>{ u0 }, h0, params.e, &controller);
+		if (params.method == Method::GBS)
+			return RK_embedded_OLP(gbs, x0, State<1>{ u0 }, h0, params.e, &controller);
+		if (is_stiff(params.method))
+			return RK_embedded_OLP(stiff, x0, State<1>{ u0 }, h0, params.e, &controller);
+		return RK_embedded_OLP(stepper, x0, State<1>{ u0 }, h0, params.e, &controller);
+	};
+	const bool save = !params.save_at.empty();
+	std::size_t next = first_save_point(params);
+	auto save_row = [&](std::size_t k, double x_k, const State<1>& v_k) {
+		if (!keep_rows)
+			return;
+		Table_row row;
+		row.i = k;
+		row.x = x_k;
+		row.v = v_k[0];
+		row.h = x - last_x;
+		if (has_true_solution) {
+			row.u = true_trajectory(x_k, params.u0);
+			row.u_v = std::abs(row.u - row.v);
+		}
+		result.rows.push_back(row);
+	};
+	if (params.auto_h)
+		h = initial_step<1>(Scalar_rhs<F>{ f }, params.xmin, State<1>{ params.u0 }, error_order(params.method), params.e, params.xmax - params.xmin, result.rhs_calls);
+	if (keep_rows && !save)
+		result.rows.push_back(first_row(params.xmin, params.u0, has_true_solution));
+
+	std::size_t i = 1;
+	const double OLP_multiplier = OLP_factor(params.method);
+
+	for (; integrating(params, x, next) && (i < params.Max_steps); ) {
+		std::size_t C1 = 0, C2 = 0;
+		last_x = x;
+		double last_v = v;
+
+		//     xmax,      
+		RK_COUNT(endpoint_clamps, h > params.xmax - x ? 1 : 0);
+		new_point = OLP(x, v, std::fmin(h, params.xmax - x));
+		result.rhs_calls += new_point.rhs_calls;
+		if (new_point.failed) {
+			result.failed = true;
+			break;
+		}
+
+		x = new_point.x_n;
+		v = new_point.v[0];
+		h = new_point.h;
+		if (new_point.swich < 0)
+			C1 = static_cast<std::size_t>(-new_point.swich);
+		if (new_point.swich > 0 && x + h <= params.xmax)
+			C2 = 1;
+		if (params.method == Method::AUTO)
+			(switching.implicit() ? result.implicit_steps : result.explicit_steps)++;
+		if (save && params.method == Method::AUTO)
+			save_points<1>(params, next, hermite, switching, last_x, State<1>{ last_v }, x, State<1>{ v }, result.rhs_calls, save_row);
+		else if (save && params.method == Method::ABM)
+			save_points<1>(params, next, hermite, adams, last_x, State<1>{ last_v }, x, State<1>{ v }, result.rhs_calls, save_row);
+		else if (save && params.method == Method::GBS)
+			save_points<1>(params, next, hermite, gbs, last_x, State<1>{ last_v }, x, State<1>{ v }, result.rhs_calls, save_row);
+		else if (save && is_stiff(params.method))
+			save_points<1>(params, next, hermite, stiff, last_x, State<1>{ last_v }, x, State<1>{ v }, result.rhs_calls, save_row);
+		else if (save)
+			save_points<1>(params, next, hermite, stepper, last_x, State<1>{ last_v }, x, State<1>{ v }, result.rhs_calls, save_row);
+
+		Table_row row;
+		row.i = i;
+		row.x = x;
+		row.v = v;
+		row.v_2h = new_point.v_2h[0];
+		row.v_v_2h = std::abs(v - row.v_2h);
+		row.OLP = row.v_v_2h * OLP_multiplier;
+		row.h = x - last_x;
+		row.C1 = C1;
+		row.C2 = C2;
+		if (has_true_solution) {
+			row.u = true_trajectory(x, params.u0);
+			row.u_v = std::abs(row.u - v);
+		}
+		add_row(result, row, keep_rows && !save);
+		i++;
+	}
+	result.n = i;
+	result.b_x_n = params.xmax - x;
+	result.v_n = v;
+	result.accepted_steps = controller.accepted;
+	result.rejected_steps = controller.rejected;
+	result.jacobians = stiff.jacobians;
+	result.factorizations = stiff.factorizations;
+	result.method_switches = switching.switches;
+	result.output_failed = !result.rows.flush();
+	result.counters = counters_snapshot() - counters_start;
+	return result;
+}
+
+Task_result run_test_fixed(const Task_params& params, bool keep_rows) {
+	return with_scheme(params.scheme, [&](auto tableau) {
+		return run_scalar_fixed<decltype(tableau)>(Test_function(), params, true, keep_rows);
+	});
+}
+
+Task_result run_test_adaptive(const Task_params& params, bool keep_rows) {
+	return run_scalar_adaptive(Test_function(), params, true, keep_rows);
+}
+
+Task_result run_task1_adaptive(const Task_params& params, bool keep_rows) {
+	return with_rhs(params, 1, Function_1(), [&](auto f) {
+		return run_scalar_adaptive(f, params, false, keep_rows);
+	});
+}
+
+Task_result run_task1_fixed(const Task_params& params, bool keep_rows) {
+	return with_rhs(params, 1, Function_1(), [&](auto f) {
+		return with_scheme(params.scheme, [&](auto tableau) {
+			return run_scalar_fixed<decltype(tableau)>(f, params, false, keep_rows);
+		});
+	});
+}
+
+/*
+*	 run_phase -    2    rhs (Function_2  Program_rhs)
+*/
+template <class F>
+static Task_result run_phase(F rhs, const Task_params& params, bool keep_rows) {
+	RK_PHASE(Phase::Other);
+	const Solver_counters counters_start = counters_snapshot();
+	Task_result result;
+	result.is_system = true;
+	prepare_rows(result, params, adaptive_rows(params), keep_rows);
+	double h = params.h;
+	double v_1 = params.u0_1;
+	double v_2 = params.u0_2;
+	double x = params.xmin;
+	OLP_step<2> new_point;
+	Embedded_stepper<2, F> stepper(params.method, rhs);
+	Stiff_stepper<2, F> stiff(implicit_method(params.method), rhs);
+	stiff.tolerance = params.e;
+	Switching_stepper<decltype(stepper), decltype(stiff)> switching(stepper, stiff);
+	Adams_stepper<2, F> adams(rhs);
+	Extrapolation_stepper<2, F> gbs(rhs);
+	gbs.tolerance = params.e;
+	Step_controller controller;
+	controller.type = params.control;
+	auto OLP = [&](double x0, double u0_1, double u0_2, double h0) {
+		if (params.method == Method::RK4)
+			return RK_4_OLP_for_system(rhs, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::AUTO)
+			return RK_embedded_OLP(switching, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::ABM)
+			return RK_embedded_OLP(adams, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::GBS)
+			return RK_embedded_OLP(gbs, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (is_stiff(params.method))
+			return RK_embedded_OLP(stiff, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		return RK_embedded_OLP(stepper, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+	};
+	if (params.auto_h)
+		h = initial_step<2>(rhs, params.xmin, State<2>{ v_1, v_2 }, error_order(params.method), params.e, params.xmax - params.xmin, result.rhs_calls);
+	if (keep_rows) {
+		Table_row row = first_row(params.xmin, v_1, false);
+		row.v2 = v_2;
+		result.rows.push_back(row);
+	}
+
+	std::size_t i = 1;
+	for (; (x <= params.xmax - params.border) && (i < params.Max_steps); ) {
+		double last_x = x;
+		new_point = OLP(x, v_1, v_2, h);
+		result.rhs_calls += new_point.rhs_calls;
+		if (new_point.failed) {
+			result.failed = true;
+			break;
+		}
+
+		x = new_point.x_n;
+		v_1 = new_point.v[0];
+		v_2 = new_point.v[1];
+		h = new_point.h;
+		if (params.method == Method::AUTO)
+			(switching.implicit() ? result.implicit_steps : result.explicit_steps)++;
+
+		if (keep_rows) {
+			RK_PHASE(Phase::Output);
+			Table_row row;
+			row.i = i;
+			row.x = x;
+			row.v = v_1;
+			row.v_2h = new_point.v_2h[0];
+			row.h = x - last_x;
+			row.v2 = v_2;
+			row.v2_2h = new_point.v_2h[1];
+			result.rows.push_back(row);
+		}
+		i++;
+	}
+	result.n = i;
+	result.b_x_n = params.xmax - x;
+	result.v_n = v_1;
+	result.v2_n = v_2;
+	result.accepted_steps = controller.accepted;
+	result.rejected_steps = controller.rejected;
+	result.jacobians = stiff.jacobians;
+	result.factorizations = stiff.factorizations;
+	result.method_switches = switching.switches;
+	result.output_failed = !result.rows.flush();
+	result.counters = counters_snapshot() - counters_start;
+	return result;
+}
+
+Task_result run_task2_phase(const Task_params& params, bool keep_rows) {
+	return with_rhs(params, 2, Function_2{ params.a, params.b }, [&](auto rhs) {
+		return run_phase(rhs, params, keep_rows);
+	});
+}
+
+/*
+*	 run_system_fixed -        2     Tableau
+*/
+template <class Tableau, class F>
+static Task_result run_system_fixed(F rhs, const Task_params& params, bool keep_rows) {
+	RK_PHASE(Phase::Other);
+	const Solver_counters counters_start = counters_snapshot();
+	Task_result result;
+	result.is_system = true;
+	prepare_rows(result, params, (params.xmax - params.xmin) / params.h + 2, keep_rows);
+	double h = params.h;
+	Explicit_stepper<Tableau, 2, F> stepper(rhs);
+	State<2> v = { params.u0_1, params.u0_2 };
+	State<2> v_last = v;
+	State<2> v_2h;
+	if (keep_rows) {
+		Table_row row = first_row(params.xmin, v[0], false);
+		row.v2 = v[1];
+		result.rows.push_back(row);
+	}
+
+	std::size_t i = 1;
+	double x = params.xmin + h;
+
+	for (; (x <= params.xmax) && (i < params.Max_steps); x += h)
+	{
+		v_last = v;
+		stepper.step_doubling(x, h, v_last, v, v_2h);
+
+		Table_row row;
+		row.i = i;
+		row.x = x;
+		row.v = v[0];
+		row.v_2h = v_2h[0];
+		row.v_v_2h = std::abs(v[0] - v_2h[0]);
+		row.OLP = row.v_v_2h / S_divisor<Tableau> * OLP_scale<Tableau>;
+		row.h = h;
+		row.v2 = v[1];
+		row.v2_2h = v_2h[1];
+		add_row(result, row, keep_rows);
+		i++;
+	}
+	result.n = i;
+	result.b_x_n = params.xmax - x + h;
+	result.v_n = v[0];
+	result.v2_n = v[1];
+	result.rhs_calls = stepper.rhs_calls;
+	result.output_failed = !result.rows.flush();
+	result.counters = counters_snapshot() - counters_start;
+	return result;
+}
+
+Task_result run_task2_fixed(const Task_params& params, bool keep_rows) {
+	return with_rhs(params, 2, Function_2{ params.a, params.b }, [&](auto rhs) {
+		return with_scheme(params.scheme, [&](auto tableau) {
+			return run_system_fixed<decltype(tableau)>(rhs, params, keep_rows);
+		});
+	});
+}
+
+/*
+*	 run_system_adaptive -        2    rhs
+*/
+template <class F>
+static Task_result run_system_adaptive(F rhs, const Task_params& params, bool keep_rows) {
+	RK_PHASE(Phase::Other);
+	const Solver_counters counters_start = counters_snapshot();
+	Task_result result;
+	result.is_system = true;
+	prepare_rows(result, params, adaptive_rows(params), keep_rows);
+	double h = params.h;
+	double v_1 = params.u0_1;
+	double v_2 = params.u0_2;
+	double x = params.xmin;
+	double last_x = params.xmin;
+	OLP_step<2> new_point;
+	Embedded_stepper<2, F> stepper(params.method, rhs);
+	Stiff_stepper<2, F> stiff(implicit_method(params.method), rhs);
+	stiff.tolerance = params.e;
+	Switching_stepper<decltype(stepper), decltype(stiff)> switching(stepper, stiff);
+	Adams_stepper<2, F> adams(rhs);
+	Extrapolation_stepper<2, F> gbs(rhs);
+	gbs.tolerance = params.e;
+	Hermite_dense<2, F> hermite(rhs);
+	Step_controller controller;
+	controller.type = params.control;
+	auto OLP = [&](double x0, double u0_1, double u0_2, double h0) {
+		if (params.method == Method::RK4)
+			return RK_4_OLP_for_system(rhs, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::AUTO)
+			return RK_embedded_OLP(switching, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::ABM)
+			return RK_embedded_OLP(adams, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (params.method == Method::GBS)
+			return RK_embedded_OLP(gbs, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		if (is_stiff(params.method))
+			return RK_embedded_OLP(stiff, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+		return RK_embedded_OLP(stepper, x0, State<2>{ u0_1, u0_2 }, h0, params.e, &controller);
+	};
+	const bool save = !params.save_at.empty();
+	std::size_t next = first_save_point(params);
+	auto save_row = [&](std::size_t k, double x_k, const State<2>& v_k) {
+		if (!keep_rows)
+			return;
+		Table_row row;
+		row.i = k;
+		row.x = x_k;
+		row.v = v_k[0];
+		row.h = x - last_x;
+		row.v2 = v_k[1];
+		result.rows.push_back(row);
+	};
+	if (params.auto_h)
+		h = initial_step<2>(rhs, params.xmin, State<2>{ v_1, v_2 }, error_order(params.method), params.e, params.xmax - params.xmin, result.rhs_calls);
+	if (keep_rows && !save) {
+		Table_row row = first_row(params.xmin, v_1, false);
+		row.v2 = v_2;
+		result.rows.push_back(row);
+	}
+
+	std::size_t i = 1;
+	const double OLP_multiplier = OLP_factor(params.method);
+
+	for (; integrating(params, x, next) && (i < params.Max_steps); ) {
+		std::size_t C1 = 0, C2 = 0;
+		last_x = x;
+		State<2> last_v = { v_1, v_2 };
+
+		//     xmax,      
+		RK_COUNT(endpoint_clamps, h > params.xmax - x ? 1 : 0);
+		new_point = OLP(x, v_1, v_2, std::fmin(h, params.xmax - x));
+		result.rhs_calls += new_point.rhs_calls;
+		if (new_point.failed) {
+			result.failed = true;
+			break;
+		}
+
+		x = new_point.x_n;
+		v_1 = new_point.v[0];
+		v_2 = new_point.v[1];
+		h = new_point.h;
+		if (new_point.swich < 0)
+			C1 = static_cast<std::size_t>(-new_point.swich);
+		if (new_point.swich > 0 && x + h <= params.xmax)
+			C2 = 1;
+		if (params.method == Method::AUTO)
+			(switching.implicit() ? result.implicit_steps : result.explicit_steps)++;
+		if (save && params.method == Method::AUTO)
+			save_points<2>(params, next, hermite, switching, last_x, last_v, x, State<2>{ v_1, v_2 }, result.rhs_calls, save_row);
+		else if (save && params.method == Method::ABM)
+			save_points<2>(params, next, hermite, adams, last_x, last_v, x, State<2>{ v_1, v_2 }, result.rhs_calls, save_row);
+		else if (save && params.method == Method::GBS)
+			save_points<2>(params, next, hermite, gbs, last_x, last_v, x, State<2>{ v_1, v_2 }, result.rhs_calls, save_row);
+		else if (save && is_stiff(params.method))
+			save_points<2>(params, next, hermite, stiff, last_x, last_v, x, State<2>{ v_1, v_2 }, result.rhs_calls, save_row);
+		else if (save)
+			save_points<2>(params, next, hermite, stepper, last_x, last_v, x, State<2>{ v_1, v_2 }, result.rhs_calls, save_row);
+
+		Table_row row;
+		row.i = i;
+		row.x = x;
+		row.v = v_1;
+		row.v_2h = new_point.v_2h[0];
+		row.v_v_2h = std::abs(v_1 - row.v_2h);
+		row.OLP = row.v_v_2h * OLP_multiplier;
+		row.h = x - last_x;
+		row.C1 = C1;
+		row.C2 = C2;
+		row.v2 = v_2;
+		row.v2_2h = new_point.v_2h[1];
+		add_row(result, row, keep_rows && !save);
+		i++;
+	}
+	result.n = i;
+	result.b_x_n = params.xmax - x;
+	result.v_n = v_1;
+	result.v2_n = v_2;
+	result.accepted_steps = controller.accepted;
+	result.rejected_steps = controller.rejected;
+	result.jacobians = stiff.jacobians;
+	result.factorizations = stiff.factorizations;
+	result.method_switches = switching.switches;
+	result.output_failed = !result.rows.flush();
+	result.counters = counters_snapshot() - counters_start;
+	return result;
+}
+
+Task_result run_task2_adaptive(const Task_params& params, bool keep_rows) {
+	return with_rhs(params, 2, Function_2{ params.a, params.b }, [&](auto rhs) {
+		return run_system_adaptive(rhs, params, keep_rows);
+	});
+}
+
+Task_result run_task(int button, const Task_params& params, bool keep_rows) {
+	switch (button) {
+	case 1: return run_test_fixed(params, keep_rows);
+	case 2: return run_task2_phase(params, keep_rows);
+	case 3: return run_test_adaptive(params, keep_rows);
+	case 4: return run_task1_adaptive(params, keep_rows);
+	case 5: return run_task1_fixed(params, keep_rows);
+	case 6: return run_task2_fixed(params, keep_rows);
+	case 7: return run_task2_adaptive(params, keep_rows);
+	}
+	return Task_result();
+}
+
+/*
+*	 run_ensemble -       x,    run_scalar_fixed,   
+*/
+static std::size_t run_ensemble(RK_4_ensemble& ensemble, const Task_params& params) {
+	double h = params.h;
+	std::size_t i = 1;
+	for (double x = params.xmin + h; (x <= params.xmax) && (i < params.Max_steps); x += h) {
+		ensemble.step(x, h);
+		i++;
+	}
+	return i - 1;
+}
+
+/*
+*	 batch_rhs -   :  params.rhs,      
+*	(  -  a, b),    builtin
+*	std::vector<double>& registers -   ( params.native -  a, b    ),
+*	 ,   
+*/
+static Batch_function batch_rhs(const Task_params& params, std::size_t dimension, Batch_rhs builtin, std::vector<double>& registers) {
+	if (params.rhs == nullptr)
+		return builtin;
+	if (params.native != nullptr) {
+		check_rhs(params, dimension);
+		registers.assign(2 * Ensemble_lanes, params.a);
+		std::fill(registers.begin() + Ensemble_lanes, registers.end(), params.b);
+		Native_batch_function f = params.native->batch();
+		const double* ab = registers.data();
+		return [f, ab](double x, const double* v, double* dv, const double* coeffs) {
+			f(x, v, dv, coeffs != nullptr ? coeffs : ab, Ensemble_lanes);
+		};
+	}
+	registers = program_registers(params, dimension, Ensemble_lanes);
+	const Rhs_program* program = params.rhs;
+	double* r = registers.data();
+	return [program, r](double x, const double* v, double* dv, const double* coeffs) {
+		program->eval_batch(x, v, dv, coeffs, Ensemble_lanes, r);
+	};
+}
+
+std::vector<double> run_task1_ensemble(const Task_params& params, const std::vector<double>& u0, std::size_t* steps) {
+	std::vector<double> registers;
+	RK_4_ensemble ensemble(batch_rhs(params, 1, function_1_batch, registers), 1, u0.size());
+	for (std::size_t m = 0; m < u0.size(); m++)
+		ensemble.set(m, &u0[m]);
+	const std::size_t count = run_ensemble(ensemble, params);
+	if (steps != nullptr)
+		*steps = count;
+
+	std::vector<double> v(u0.size());
+	for (std::size_t m = 0; m < v.size(); m++)
+		v[m] = ensemble.value(m, 0);
+	return v;
+}
+
+std::vector<State<2>> run_task2_ensemble(const Task_params& params, const std::vector<Task2_member>& members, std::size_t* steps) {
+	std::vector<double> registers;
+	RK_4_ensemble ensemble(batch_rhs(params, 2, function_2_batch, registers), 2, members.size(), 2);
+	for (std::size_t m = 0; m < members.size(); m++) {
+		const double u0[2] = { members[m].u0_1, members[m].u0_2 };
+		const double coeffs[2] = { members[m].a, members[m].b };
+		ensemble.set(m, u0, coeffs);
+	}
+	const std::size_t count = run_ensemble(ensemble, params);
+	if (steps != nullptr)
+		*steps = count;
+
+	std::vector<State<2>> v(members.size());
+	for (std::size_t m = 0; m < v.size(); m++)
+		v[m] = { ensemble.value(m, 0), ensemble.value(m, 1) };
+	return v;
+}
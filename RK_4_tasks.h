@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "RK_4.h"
+#include "RK_dense.h"
+#include "RK_embedded.h"
+#include "RK_ensemble.h"
+#include "RK_native.h"
+#include "RK_stats.h"
+#include "RK_trajectory.h"
+
+class Trajectory_writer;
+
+/*
+*	Task_params -    (  textBox1 - textBox11)
+*/
+struct Task_params {
+	double xmin = 0;			// x_min
+	double xmax = 1;			// x_max
+	double h = 0.1;				// h -  
+	double border = 0.01;		// 
+	double e = 0.00001;			// e -   
+	double u0 = 1;				// u0 -       1
+	double u0_1 = 1;			// u0_1 -   v1  2
+	double u0_2 = 1;			// u0_2 -   v2  2
+	double a = 1;				// a, b -    2
+	double b = 1;
+	std::size_t Max_steps = 1000;	//  
+	Method method = Method::RK4;	//    ( 2, 3, 4, 7)
+	Scheme scheme = Scheme::RK4;	//       ( 1, 5, 6)
+	Control control = Control::Halving;	//   
+	bool auto_h = false;			//      h
+	bool precompute = false;		//  5:  function_1,    x,  
+									//    (RK_split.h)
+	const Rhs_program* rhs = nullptr;	//    1 ( 4, 5)   2 ( 2, 6, 7),  
+									//   a, b; nullptr - function_1, function_2
+	const Native_rhs_library* native = nullptr;	// rhs,     ( -)  nullptr
+	Trajectory_writer* output = nullptr;	//         (  -   )
+	std::vector<double> save_at;	//     ( 3, 4, 7):   ,   -
+									//      ,     
+};
+
+/*
+*	Task_result -   :     textBox12 - textBox23
+*/
+struct Task_result {
+	Trajectory rows;				//    ( u, v2 -  has_true_solution  is_system)
+	bool has_true_solution = false;	//    u  |u - v|
+	bool is_system = false;			//   v2  v2_2h
+
+	std::size_t n = 0;				// n
+	double b_x_n = 0;				// b - x_n
+	double v_n = 0;					//  v (  2 - v1)   
+	double v2_n = 0;				//  v2    (  2)
+	Step_stats stats;				// max||, max h, min h, max|u_i-v_i|,     ...
+	std::size_t rhs_calls = 0;		//    
+	std::size_t accepted_steps = 0;	//       (  )
+	std::size_t rejected_steps = 0;
+	std::size_t jacobians = 0;		//      LU- (  ROS3, SDIRK4)
+	std::size_t factorizations = 0;
+	std::size_t explicit_steps = 0;	//           (--method auto)
+	std::size_t implicit_steps = 0;
+	std::size_t method_switches = 0;
+	Solver_counters counters;		//     (    RK_4_COUNTERS,  )
+	bool failed = false;			//     (OLP_step::failed):    x_n = xmax - b_x_n
+	bool output_failed = false;		//      params.output ( ,  -)
+};
+
+/*
+*	 run_* -  ,   ,    
+*	const Task_params& params -   
+*	bool keep_rows -     (     )
+*/
+//       (button1)
+Task_result run_test_fixed(const Task_params& params, bool keep_rows = true);
+//        2 (button2)
+Task_result run_task2_phase(const Task_params& params, bool keep_rows = true);
+//       (button3)
+Task_result run_test_adaptive(const Task_params& params, bool keep_rows = true);
+//  1     (button4)
+Task_result run_task1_adaptive(const Task_params& params, bool keep_rows = true);
+//  1     (button5)
+Task_result run_task1_fixed(const Task_params& params, bool keep_rows = true);
+//  2     (button6)
+Task_result run_task2_fixed(const Task_params& params, bool keep_rows = true);
+//  2     (button7)
+Task_result run_task2_adaptive(const Task_params& params, bool keep_rows = true);
+
+/*
+*	 run_task -       (1 - 7)
+*/
+Task_result run_task(int button, const Task_params& params, bool keep_rows = true);
+
+/*
+*	Task2_member -         2
+*/
+struct Task2_member {
+	double u0_1 = 1;
+	double u0_2 = 1;
+	double a = 1;
+	double b = 1;
+};
+
+/*
+*	 run_*_ensemble -      ( button5  button6)
+*	       xmin, xmax, h  Max_steps  params (RK_4_ensemble)
+*	  v       (  2 - { v1, v2 })
+*	std::size_t* steps -   nullptr,      
+*/
+std::vector<double> run_task1_ensemble(const Task_params& params, const std::vector<double>& u0, std::size_t* steps = nullptr);
+std::vector<State<2>> run_task2_ensemble(const Task_params& params, const std::vector<Task2_member>& members, std::size_t* steps = nullptr);
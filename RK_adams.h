@@ -0,0 +1,307 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include "RK_4_system.h"
+#include "RK_dense.h"
+#include "RK_explicit.h"
+
+/*
+*	 Derivative_history -    Capacity  x_i   f(x_i, v_i)  
+*	      ,      
+*	x(0), f(0) -  , x(i), f(i) -  i  
+*	difference(j) -   f[x(0), ..., x(j)], j < size();   
+*	      (Capacity   Capacity^2 / 2)
+*/
+template <std::size_t N, std::size_t Capacity>
+class Derivative_history {
+public:
+	typedef State<N> state_type;
+
+	explicit Derivative_history(std::size_t n = N) {
+		for (std::size_t i = 0; i < Capacity; i++) {
+			fs[i] = make_state<N>(n);
+			d[i] = make_state<N>(n);
+		}
+	}
+
+	std::size_t size() const { return count; }
+	void clear() { count = 0; }
+
+	/*
+	*	 push -   x_new   f_new
+	*/
+	void push(double x_new, const state_type& f_new) {
+		head = (head + 1) % Capacity;
+		if (count < Capacity)
+			count++;
+		xs[head] = x_new;
+		fs[head] = f_new;
+
+		double inverse[Capacity];
+		for (std::size_t j = 1; j < count; j++)
+			inverse[j] = 1 / (x_new - x(j));
+		for (std::size_t l = 0; l < f_new.size(); l++) {
+			// f[x_new, x(1), ..., x(j)] = (f[x_new, ..., x(j - 1)] - f[x(1), ..., x(j)]) / (x_new - x(j))
+			double next = f_new[l], previous = d[0][l];
+			d[0][l] = next;
+			for (std::size_t j = 1; j < count; j++) {
+				const double old = d[j][l];
+				next = (next - previous) * inverse[j];
+				d[j][l] = next;
+				previous = old;
+			}
+		}
+	}
+
+	double x(std::size_t i) const { return xs[(head + Capacity - i) % Capacity]; }
+	const state_type& f(std::size_t i) const { return fs[(head + Capacity - i) % Capacity]; }
+	const state_type& difference(std::size_t j) const { return d[j]; }
+
+private:
+	std::array<double, Capacity> xs{};
+	std::array<state_type, Capacity> fs;
+	std::array<state_type, Capacity> d;
+	std::size_t head = 0;
+	std::size_t count = 0;
+};
+
+/*
+*	 Adams_stepper -    -  -  PECE     k = 1 ... Max_order
+*	(, ͸, , III.5, III.7):   2     4 (RK4)  6 (DP54)
+*	     Derivative_history      x;
+*	  u = (x - x_n) / h  D_j = f[u_n, ..., u_(n-j)] = h^j f[x_n, ..., x_(n-j)],
+*	       ,       
+*	P:     k: p = v_n + h sum_(j<k) D_j int_0^1 prod_(i<j) (u - u_(n-i)) du
+*	E: f(x_n + h, p)
+*	C:     k + 1        (E_j -    )
+*	E: f(x_n + h, v_next) ,     (  - 1   )
+*	   -    h E_k int_0^1 ...,    
+*	 k + 1  k;     k - 1  k + 1     
+*	 -  RK_4_stepper (Runge_Kytta_4)     ,     Start_order 
+*	  ,     (    );       
+*	F f -     f(x, v, dv) (Scalar_rhs, System_call,   Function_2, )
+*	std::size_t n -   (   N = Dynamic)
+*/
+template <std::size_t N, class F>
+class Adams_stepper {
+public:
+	typedef State<N> state_type;
+	static const std::size_t dimension = N;
+	static const int Max_order = 12;
+	static const int Start_order = Classic_RK4::order;
+
+	Adams_stepper(F f, std::size_t n = N)
+		: f(f), n(N == Dynamic ? n : N), history(n), starter(f, n), v_start(make_state<N>(n)), v_end(make_state<N>(n)),
+		v_full(make_state<N>(n)), f_end(make_state<N>(n)), predicted(make_state<N>(n)) {
+		for (std::size_t j = 0; j < Terms; j++) {
+			D[j] = make_state<N>(n);
+			E[j] = make_state<N>(n);
+		}
+	}
+
+	std::size_t size() const { return n; }
+
+	/*
+	*	 error_order -   : k   , p  
+	*/
+	int error_order() const { return starting ? Start_order : order; }
+
+	/*
+	*	 step -   ( Embedded_stepper  RK_embedded_OLP)
+	*	state_type& v_next -  v   x_n + h_n, state_type& v_hat - v_next   
+	*	(v_next  v_hat     v_n)
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		if (x_n == x_end && v_n == v_end)
+			accept();
+		else if (!(x_n == x_start && v_n == v_start))
+			restart(x_n, v_n);
+		x_start = x_n;
+		x_end = x_n + h_n;
+		h = h_n;
+		end_ready = false;
+
+		if (starting) {
+			rhs_calls += starter.step_doubling(x_n, h_n, v_n, v_full, v_next);
+			for (std::size_t i = 0; i < n; i++)
+				v_hat[i] = v_next[i] - (v_next[i] - v_full[i]) / ((1 << Start_order) - 1);
+		}
+		else
+			adams_step(v_next, v_hat);
+		v_end = v_next;
+	}
+
+	/*
+	*	 dense -    :   ,
+	*	  -    (  f   )
+	*	double t -  , 0 <= t <= 1
+	*/
+	void dense(double t, state_type& v) {
+		if (starting) {
+			end_derivative();
+			hermite<N>(t, h, v_start, history.f(0), v_end, f_end, v);
+			return;
+		}
+		double weights[Terms];
+		integrals(nodes, order, t, weights);
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0;
+			for (int j = order; j >= 0; j--)
+				sum += weights[j] * E[j][i];
+			v[i] = v_start[i] + h * sum;
+		}
+	}
+
+	std::size_t rhs_calls = 0;	//     ( )
+	int order = Start_order;	//  k    
+
+private:
+	static const std::size_t Terms = Max_order + 2;
+	static constexpr double Reciprocal[Terms + 1] = { 1.0, 1.0 / 2, 1.0 / 3, 1.0 / 4, 1.0 / 5, 1.0 / 6, 1.0 / 7, 1.0 / 8,
+		1.0 / 9, 1.0 / 10, 1.0 / 11, 1.0 / 12, 1.0 / 13, 1.0 / 14, 1.0 / 15 };	// 1 / (m + 1)
+
+	/*
+	*	 integrals - I_j = int_0^t prod_(i<j) (u - z_i) du  j = 0 ... count
+	*	  M_j[m] = int_0^t prod_(i<j) (u - z_i) u^m du = M_(j-1)[m + 1] - z_(j-1) M_(j-1)[m]
+	*	(O(count^2)      )
+	*/
+	static void integrals(const double* z, int count, double t, double* I) {
+		double M[Terms + 1] = {};
+		double power = t;
+		for (int m = 0; m <= count; m++) {
+			M[m] = power * Reciprocal[m];
+			power *= t;
+		}
+		I[0] = M[0];
+		for (int j = 1; j <= count; j++) {
+			for (int m = 0; m <= count - j; m++)
+				M[m] = M[m + 1] - z[j - 1] * M[m];
+			I[j] = M[0];
+		}
+	}
+
+	/*
+	*	 adams_step -  PECE  order    
+	*/
+	void adams_step(state_type& v_next, state_type& v_hat) {
+		const int available = (int)std::min<std::size_t>(history.size(), order + 1);
+		double z[Terms];
+		double scale = 1;
+		const double inverse_h = 1 / h;
+		for (int i = 0; i < available; i++) {
+			z[i] = (history.x(i) - x_start) * inverse_h;
+			const state_type& d = history.difference(i);
+			for (std::size_t l = 0; l < n; l++)
+				D[i][l] = d[l] * scale;
+			scale *= h;
+		}
+
+		double weights[Terms];
+		integrals(z, order, 1, weights);
+		for (std::size_t l = 0; l < n; l++) {
+			double sum = 0;
+			for (int j = order - 1; j >= 0; j--)
+				sum += weights[j] * D[j][l];
+			predicted[l] = v_start[l] + h * sum;
+		}
+		call_rhs(f, x_end, predicted.data(), E[0].data());
+		rhs_calls++;
+
+		nodes[0] = 1;
+		for (int i = 0; i < available; i++)
+			nodes[i + 1] = z[i];
+		for (int j = 1; j <= available; j++) {
+			const double inverse = 1 / (1 - z[j - 1]);
+			for (std::size_t l = 0; l < n; l++)
+				E[j][l] = (E[j - 1][l] - D[j - 1][l]) * inverse;
+		}
+		integrals(nodes, available, 1, weights);
+		for (std::size_t l = 0; l < n; l++) {
+			double sum = 0;
+			for (int j = order; j >= 0; j--)
+				sum += weights[j] * E[j][l];
+			v_next[l] = v_start[l] + h * sum;
+			v_hat[l] = v_next[l] - h * weights[order] * E[order][l];
+		}
+
+		//     k - 1  k + 1   
+		error = error_lower = 0;
+		error_higher = INFINITY;
+		for (std::size_t l = 0; l < n; l++) {
+			error = std::fmax(error, std::abs(weights[order] * E[order][l]));
+			error_lower = std::fmax(error_lower, std::abs(weights[order - 1] * E[order - 1][l]));
+		}
+		if (available > order) {
+			error_higher = 0;
+			for (std::size_t l = 0; l < n; l++)
+				error_higher = std::fmax(error_higher, std::abs(weights[order + 1] * E[order + 1][l]));
+		}
+	}
+
+	/*
+	*	 end_derivative - f(x_n + h, v_next)   (  )
+	*/
+	void end_derivative() {
+		if (end_ready)
+			return;
+		call_rhs(f, x_end, v_end.data(), f_end.data());
+		rhs_calls++;
+		end_ready = true;
+	}
+
+	/*
+	*	 accept -    :   -  ,  
+	*	(,    k - 1 ;      k + 1    )
+	*/
+	void accept() {
+		end_derivative();
+		history.push(x_end, f_end);
+		v_start = v_end;
+		if (starting) {
+			if (history.size() >= (std::size_t)Start_order) {
+				starting = false;
+				order = Start_order;
+				order_steps = 0;
+			}
+			return;
+		}
+		order_steps++;
+		if (order > 1 && error_lower <= error) {
+			order--;
+			order_steps = 0;
+		}
+		else if (order < Max_order && order_steps > order && error_higher < error) {
+			order++;
+			order_steps = 0;
+		}
+	}
+
+	/*
+	*	 restart -     (x_n, v_n):    , 
+	*/
+	void restart(double x_n, const state_type& v_n) {
+		history.clear();
+		call_rhs(f, x_n, v_n.data(), f_end.data());
+		rhs_calls++;
+		history.push(x_n, f_end);
+		starting = true;
+		v_start = v_n;
+	}
+
+	F f;
+	std::size_t n;
+	Derivative_history<N, Max_order + 1> history;
+	RK_4_stepper<N, F> starter;
+	bool starting = true;
+	int order_steps = 0;			//     
+	double x_start = NAN, x_end = NAN, h = 0;
+	state_type v_start, v_end, v_full;
+	bool end_ready = false;
+	state_type f_end;
+	state_type predicted;
+	std::array<state_type, Terms> D, E;	//        ( )
+	double nodes[Terms + 1] = {};		//     u: 1, u_n = 0, u_(n-1), ...
+	double error = 0, error_lower = 0, error_higher = INFINITY;
+};
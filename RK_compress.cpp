@@ -0,0 +1,391 @@
+#include <cstring>
+#include "RK_compress.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+*	 leading_zeros, trailing_zeros -       (x != 0)
+*/
+static int leading_zeros(std::uint64_t x) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - (int)index;
+#else
+	return __builtin_clzll(x);
+#endif
+}
+
+static int trailing_zeros(std::uint64_t x) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return (int)index;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+static std::uint64_t low_bits(int bits) {
+	return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+/*
+*	Bit_writer -  ,   
+*/
+struct Bit_writer {
+	std::vector<unsigned char>& out;
+	std::uint64_t acc = 0;
+	int used = 0;
+
+	explicit Bit_writer(std::vector<unsigned char>& out) : out(out) {}
+
+	void write(std::uint64_t value, int bits) {
+		while (bits > 0) {
+			int take = bits < 56 - used ? bits : 56 - used;
+			acc = (acc << take) | ((value >> (bits - take)) & low_bits(take));
+			used += take;
+			bits -= take;
+			while (used >= 8) {
+				out.push_back(static_cast<unsigned char>(acc >> (used - 8)));
+				used -= 8;
+			}
+			acc &= low_bits(used);
+		}
+	}
+
+	void finish() {
+		if (used > 0)
+			out.push_back(static_cast<unsigned char>(acc << (8 - used)));
+		acc = 0;
+		used = 0;
+	}
+};
+
+/*
+*	Bit_reader -  ,  Bit_writer (    )
+*/
+struct Bit_reader {
+	const unsigned char* p;
+	const unsigned char* end;
+	std::uint64_t acc = 0;
+	int avail = 0;
+
+	Bit_reader(const unsigned char* data, std::size_t size) : p(data), end(data + size) {}
+
+	bool exhausted() const { return p == end && avail == 0; }
+
+	std::uint64_t read(int bits) {
+		std::uint64_t result = 0;
+		while (bits > 0) {
+			if (avail == 0)
+				refill();
+			int take = bits < avail ? bits : avail;
+			std::uint64_t part = (acc >> (avail - take)) & low_bits(take);
+			result = take == 64 ? part : (result << take) | part;
+			avail -= take;
+			bits -= take;
+		}
+		return result;
+	}
+
+	bool overrun = false;
+
+private:
+	void refill() {
+		while (avail <= 56) {
+			if (p == end) {
+				if (avail > 0)
+					return;
+				overrun = true;
+				acc = 0;
+				avail = 64;
+				return;
+			}
+			acc = (acc << 8) | *p++;
+			avail += 8;
+		}
+	}
+};
+
+void encode_xor(const double* values, std::size_t n, std::vector<unsigned char>& out) {
+	if (n == 0)
+		return;
+	Bit_writer bits(out);
+	std::uint64_t prev;
+	std::memcpy(&prev, &values[0], 8);
+	bits.write(prev, 64);
+	int prev_lead = -1, prev_trail = 0;
+
+	for (std::size_t k = 1; k < n; k++) {
+		std::uint64_t value;
+		std::memcpy(&value, &values[k], 8);
+		std::uint64_t x = value ^ prev;
+		prev = value;
+		if (x == 0) {
+			bits.write(0, 1);
+			continue;
+		}
+		int lead = leading_zeros(x);
+		int trail = trailing_zeros(x);
+		if (lead > 31)
+			lead = 31;
+		if (prev_lead >= 0 && lead >= prev_lead && trail >= prev_trail) {
+			//       
+			bits.write(2, 2);
+			bits.write(x >> prev_trail, 64 - prev_lead - prev_trail);
+		}
+		else {
+			int significant = 64 - lead - trail;
+			bits.write(3, 2);
+			bits.write(lead, 5);
+			bits.write(significant - 1, 6);
+			bits.write(x >> trail, significant);
+			prev_lead = lead;
+			prev_trail = trail;
+		}
+	}
+	bits.finish();
+}
+
+bool decode_xor(const unsigned char* data, std::size_t size, double* values, std::size_t n) {
+	if (n == 0)
+		return true;
+	Bit_reader bits(data, size);
+	std::uint64_t prev = bits.read(64);
+	std::memcpy(&values[0], &prev, 8);
+	int lead = -1, trail = 0;
+
+	for (std::size_t k = 1; k < n; k++) {
+		if (bits.read(1) != 0) {
+			if (bits.read(1) != 0) {
+				lead = static_cast<int>(bits.read(5));
+				int significant = static_cast<int>(bits.read(6)) + 1;
+				trail = 64 - lead - significant;
+				if (trail < 0)
+					return false;
+			}
+			else if (lead < 0)
+				return false;
+			prev ^= bits.read(64 - lead - trail) << trail;
+		}
+		std::memcpy(&values[k], &prev, 8);
+	}
+	return !bits.overrun;
+}
+
+/*
+*	 put_varint, get_varint -   (LEB128)
+*	 put_u64, get_u64 -  (8 , little-endian)
+*/
+static void put_varint(std::vector<unsigned char>& out, std::uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(static_cast<unsigned char>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<unsigned char>(value));
+}
+
+static bool get_varint(const unsigned char*& p, const unsigned char* end, std::uint64_t& value) {
+	value = 0;
+	for (int shift = 0; p < end && shift < 64; shift += 7) {
+		unsigned char byte = *p++;
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+static void put_u64(std::vector<unsigned char>& out, std::uint64_t value) {
+	for (int k = 0; k < 8; k++)
+		out.push_back(static_cast<unsigned char>(value >> (8 * k)));
+}
+
+static bool get_u64(const unsigned char*& p, const unsigned char* end, std::uint64_t& value) {
+	if (end - p < 8)
+		return false;
+	value = 0;
+	for (int k = 0; k < 8; k++)
+		value |= static_cast<std::uint64_t>(p[k]) << (8 * k);
+	p += 8;
+	return true;
+}
+
+void encode_rle(const std::uint64_t* values, std::size_t n, bool delta, std::vector<unsigned char>& out) {
+	if (n == 0)
+		return;
+	std::size_t start = 0;
+	if (delta) {
+		put_u64(out, values[0]);
+		start = 1;
+	}
+	std::uint64_t run_value = 0;
+	std::uint64_t run = 0;
+	for (std::size_t k = start; k < n; k++) {
+		std::uint64_t value = delta ? values[k] - values[k - 1] : values[k];
+		if (run > 0 && value == run_value) {
+			run++;
+			continue;
+		}
+		if (run > 0) {
+			put_u64(out, run_value);
+			put_varint(out, run);
+		}
+		run_value = value;
+		run = 1;
+	}
+	if (run > 0) {
+		put_u64(out, run_value);
+		put_varint(out, run);
+	}
+}
+
+bool decode_rle(const unsigned char* data, std::size_t size, std::uint64_t* values, std::size_t n, bool delta) {
+	const unsigned char* p = data;
+	const unsigned char* end = data + size;
+	std::size_t k = 0;
+	if (delta && n > 0) {
+		if (!get_u64(p, end, values[0]))
+			return false;
+		k = 1;
+	}
+	while (k < n) {
+		std::uint64_t value, run;
+		if (!get_u64(p, end, value) || !get_varint(p, end, run) || run == 0 || run > n - k)
+			return false;
+		if (delta) {
+			for (std::uint64_t r = 0; r < run; r++, k++)
+				values[k] = values[k - 1] + value;
+		}
+		else {
+			for (std::uint64_t r = 0; r < run; r++, k++)
+				values[k] = value;
+		}
+	}
+	return p == end;
+}
+
+Column_encoding encode_column(const void* values, std::size_t n, bool is_f64, std::vector<unsigned char>& out) {
+	const std::uint64_t* bits = static_cast<const std::uint64_t*>(values);
+	std::vector<unsigned char> first, second;
+	Column_encoding first_encoding, second_encoding;
+	if (is_f64) {
+		encode_xor(static_cast<const double*>(values), n, first);
+		encode_rle(bits, n, false, second);
+		first_encoding = Column_encoding::XOR;
+		second_encoding = Column_encoding::RLE;
+	}
+	else {
+		encode_rle(bits, n, false, first);
+		encode_rle(bits, n, true, second);
+		first_encoding = Column_encoding::RLE;
+		second_encoding = Column_encoding::Delta_RLE;
+	}
+
+	if (second.size() < first.size()) {
+		first.swap(second);
+		first_encoding = second_encoding;
+	}
+	if (first.size() >= 8 * n) {
+		const unsigned char* raw = static_cast<const unsigned char*>(values);
+		out.insert(out.end(), raw, raw + 8 * n);
+		return Column_encoding::Raw;
+	}
+	out.insert(out.end(), first.begin(), first.end());
+	return first_encoding;
+}
+
+bool decode_column(Column_encoding encoding, const unsigned char* data, std::size_t size, void* values, std::size_t n) {
+	switch (encoding) {
+	case Column_encoding::Raw:
+		if (size != 8 * n)
+			return false;
+		std::memcpy(values, data, size);
+		return true;
+	case Column_encoding::XOR:
+		return decode_xor(data, size, static_cast<double*>(values), n);
+	case Column_encoding::RLE:
+		return decode_rle(data, size, static_cast<std::uint64_t*>(values), n, false);
+	case Column_encoding::Delta_RLE:
+		return decode_rle(data, size, static_cast<std::uint64_t*>(values), n, true);
+	}
+	return false;
+}
+
+std::size_t Packed_trajectory::bytes() const {
+	std::size_t total = 0;
+	for (const Packed_column& column : columns)
+		total += column.bytes.size();
+	return total;
+}
+
+/*
+*	 packed_columns -     Packed_trajectory
+*	(  -   std::vector<std::size_t>,  double -  std::vector<double>)
+*/
+struct Column_ref {
+	std::vector<std::size_t>* u;
+	std::vector<double>* f;
+};
+
+static std::vector<Column_ref> packed_columns(Trajectory& rows, bool has_true_solution, bool is_system) {
+	std::vector<Column_ref> columns = {
+		{ &rows.i, nullptr }, { nullptr, &rows.x }, { nullptr, &rows.v }, { nullptr, &rows.v_2h }, { nullptr, &rows.v_v_2h },
+		{ nullptr, &rows.OLP }, { nullptr, &rows.h }, { &rows.C1, nullptr }, { &rows.C2, nullptr } };
+	if (has_true_solution) {
+		columns.push_back({ nullptr, &rows.u });
+		columns.push_back({ nullptr, &rows.u_v });
+	}
+	if (is_system) {
+		columns.push_back({ nullptr, &rows.v2 });
+		columns.push_back({ nullptr, &rows.v2_2h });
+	}
+	return columns;
+}
+
+Packed_trajectory pack(const Trajectory& rows) {
+	Packed_trajectory packed;
+	packed.rows = rows.size();
+	packed.has_true_solution = rows.has_true_solution();
+	packed.is_system = rows.is_system();
+	std::vector<std::uint64_t> counts(rows.size());
+	for (const Column_ref& column : packed_columns(const_cast<Trajectory&>(rows), packed.has_true_solution, packed.is_system)) {
+		Packed_column out;
+		if (column.f != nullptr)
+			out.encoding = encode_column(column.f->data(), packed.rows, true, out.bytes);
+		else {
+			for (std::size_t k = 0; k < packed.rows; k++)
+				counts[k] = (*column.u)[k];
+			out.encoding = encode_column(counts.data(), packed.rows, false, out.bytes);
+		}
+		out.bytes.shrink_to_fit();
+		packed.columns.push_back(std::move(out));
+	}
+	return packed;
+}
+
+bool unpack(const Packed_trajectory& packed, Trajectory& rows) {
+	rows.clear();
+	rows.set_columns(packed.has_true_solution, packed.is_system);
+	std::vector<Column_ref> columns = packed_columns(rows, packed.has_true_solution, packed.is_system);
+	if (columns.size() != packed.columns.size())
+		return false;
+	std::vector<std::uint64_t> counts(packed.rows);
+	for (std::size_t j = 0; j < columns.size(); j++) {
+		const Packed_column& in = packed.columns[j];
+		if (columns[j].f != nullptr) {
+			columns[j].f->resize(packed.rows);
+			if (!decode_column(in.encoding, in.bytes.data(), in.bytes.size(), columns[j].f->data(), packed.rows))
+				return false;
+		}
+		else {
+			if (!decode_column(in.encoding, in.bytes.data(), in.bytes.size(), counts.data(), packed.rows))
+				return false;
+			columns[j].u->assign(counts.begin(), counts.end());
+		}
+	}
+	return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RK_trajectory.h"
+
+/*
+*	Column_encoding -    ( ,   )
+*	Raw -   
+*	XOR - XOR    double,          (  Gorilla)
+*	RLE -   :  (8 )   
+*	Delta_RLE -      (  i)
+*/
+enum class Column_encoding : std::uint32_t { Raw = 0, XOR = 1, RLE = 2, Delta_RLE = 3 };
+
+/*
+*	 encode_xor -  n  double  XOR
+*	 decode_xor -  n ,  false,    
+*/
+void encode_xor(const double* values, std::size_t n, std::vector<unsigned char>& out);
+bool decode_xor(const unsigned char* data, std::size_t size, double* values, std::size_t n);
+
+/*
+*	 encode_rle -  n 64-   (delta -    )
+*	 decode_rle -  n ,  false,   
+*/
+void encode_rle(const std::uint64_t* values, std::size_t n, bool delta, std::vector<unsigned char>& out);
+bool decode_rle(const unsigned char* data, std::size_t size, std::uint64_t* values, std::size_t n, bool delta);
+
+/*
+*	 encode_column -      ,    
+*	( double - XOR  RLE,   - RLE  Delta_RLE; Raw,    )
+*	const void* values - n  double (is_f64)  uint64
+*	  
+*/
+Column_encoding encode_column(const void* values, std::size_t n, bool is_f64, std::vector<unsigned char>& out);
+
+/*
+*	 decode_column -  n   (8   )  values
+*/
+bool decode_column(Column_encoding encoding, const unsigned char* data, std::size_t size, void* values, std::size_t n);
+
+/*
+*	Packed_column, Packed_trajectory -     Trajectory
+*	   i, x, v, v_2h, v_v_2h, OLP, h, C1, C2, u, u_v, v2, v2_2h ( )
+*/
+struct Packed_column {
+	Column_encoding encoding = Column_encoding::Raw;
+	std::vector<unsigned char> bytes;
+};
+
+struct Packed_trajectory {
+	std::size_t rows = 0;
+	bool has_true_solution = false;
+	bool is_system = false;
+	std::vector<Packed_column> columns;
+
+	std::size_t bytes() const;
+};
+
+/*
+*	 pack -    
+*	 unpack -  ,  false,   
+*/
+Packed_trajectory pack(const Trajectory& rows);
+bool unpack(const Packed_trajectory& packed, Trajectory& rows);
@@ -0,0 +1,72 @@
+#include "RK_controller.h"
+
+const char* control_name(Control control) {
+	switch (control) {
+	case Control::Halving: return "halving";
+	case Control::PI: return "pi";
+	case Control::PID: return "pid";
+	}
+	return "";
+}
+
+bool parse_control(const std::string& name, Control& control) {
+	const Control controls[] = { Control::Halving, Control::PI, Control::PID };
+	for (Control c : controls)
+		if (name == control_name(c)) {
+			control = c;
+			return true;
+		}
+	return false;
+}
+
+bool Step_controller::next(double err, int k, double& factor) {
+	bool accept = decide(err, k, factor);
+	RK_COUNT(attempted, 1);
+	RK_COUNT(accepted, accept ? 1 : 0);
+	RK_COUNT(rejected, accept ? 0 : 1);
+	RK_COUNT(decreases, factor < 1 ? 1 : 0);
+	RK_COUNT(increases, accept && factor > 1 ? 1 : 0);
+	return accept;
+}
+
+bool Step_controller::decide(double err, int k, double& factor) {
+	if (type == Control::Halving) {
+		if (!(err <= 1)) {
+			factor = 0.5;
+			rejected++;
+			return false;
+		}
+		factor = err < pow(2, -k) ? 2.0 : 1.0;
+		accepted++;
+		return true;
+	}
+
+	if (!(err <= 1)) {
+		factor = std::isfinite(err) ? std::fmax(min_factor, safety * pow(err, -1.0 / k)) : min_factor;
+		last_rejected = true;
+		rejected++;
+		return false;
+	}
+
+	//   0 -     
+	double err_n = std::fmax(err, 1e-10);
+	if (type == Control::PI)
+		factor = safety * pow(err_n, -0.7 / k) * pow(err_prev, 0.4 / k);
+	else
+		factor = safety * pow(err_n, -0.58 / k) * pow(err_prev, 0.21 / k) * pow(err_prev2, -0.1 / k);
+	factor = std::fmin(max_factor, std::fmax(min_factor, factor));
+	//      
+	if (last_rejected)
+		factor = std::fmin(factor, 1.0);
+
+	err_prev2 = err_prev;
+	err_prev = std::fmax(err, 1e-4);
+	last_rejected = false;
+	accepted++;
+	return true;
+}
+
+double Step_controller::rejection_rate() const {
+	std::size_t trials = accepted + rejected;
+	return trials == 0 ? 0.0 : (double)rejected / trials;
+}
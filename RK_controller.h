@@ -0,0 +1,131 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include "RK_4_system.h"
+
+/*
+*	Control -   
+*	Halving -     S > e     S < e / 2^k (  RK_4_OLP)
+*	PI - -: h_new = h * safety * err^(-0.7 / k) * err_prev^(0.4 / k)
+*	PID - - ( ARKODE): h_new = h * safety * err^(-0.58 / k) * err_prev^(0.21 / k) * err_prev2^(-0.1 / k)
+*	err = S / e -       ,
+*	k -    + 1 ( RK_4_OLP k = p + 1)
+*/
+enum class Control { Halving, PI, PID };
+
+/*
+*	 control_name -   ("halving", "pi", "pid")
+*	 parse_control -   ,  false,   
+*/
+const char* control_name(Control control);
+bool parse_control(const std::string& name, Control& control);
+
+/*
+*	Step_controller -  
+*	         
+*/
+struct Step_controller {
+	Control type = Control::Halving;
+	double safety = 0.9;		//  
+	double min_factor = 0.2;	//   
+	double max_factor = 10;		//   
+
+	std::size_t accepted = 0;	//   
+	std::size_t rejected = 0;	//   
+
+	/*
+	*	 next -    
+	*	 true,   
+	*	double err -  S / e
+	*	int k -    + 1
+	*	double& factor -      (      )
+	*/
+	bool next(double err, int k, double& factor);
+
+	/*
+	*	 rejection_rate -      
+	*/
+	double rejection_rate() const;
+
+private:
+	/*
+	*	 decide -      (next       )
+	*/
+	bool decide(double err, int k, double& factor);
+
+	double err_prev = 1;
+	double err_prev2 = 1;
+	bool last_rejected = false;
+};
+
+/*
+*	OLP_step -      (RK_4_OLP, RK_4_OLP_for_system, RK_embedded_OLP)
+*	 N != Dynamic      
+*	double x_n -    
+*	State<N> v -  v   x_n
+*	State<N> v_2h -  v,        (   -  )
+*	double h -     (  )
+*	int swich -       
+*	std::size_t rhs_calls -    ,   
+*	bool failed -    :   x0 + h == x0 (  inf  nan
+*	  ),  x_n, v  v_2h -  
+*/
+template <std::size_t N>
+struct OLP_step {
+	double x_n = 0;
+	State<N> v{};
+	State<N> v_2h{};
+	double h = 0;
+	int swich = 0;
+	std::size_t rhs_calls = 0;
+	bool failed = false;
+};
+
+/*
+*	 initial_step -    (, ͸, , II.4)
+*	 ,        order   e
+*	F f -     f(x, v, dv) (Scalar_rhs, System_call,   Function_2, )
+*	double x0 -    
+*	const State<N>& v0 -  
+*	int order -  
+*	double e -   
+*	double h_max -    (  )
+*	std::size_t& rhs_calls -       (2)
+*/
+template <std::size_t N, class F>
+double initial_step(F f, double x0, const State<N>& v0, int order, double e, double h_max, std::size_t& rhs_calls) {
+	const std::size_t n = v0.size();
+	State<N> f0 = make_state<N>(n);
+	State<N> v1 = make_state<N>(n);
+	State<N> f1 = make_state<N>(n);
+	call_rhs(f, x0, v0.data(), f0.data());
+
+	double d0 = 0, d1 = 0;
+	for (std::size_t i = 0; i < n; i++) {
+		d0 += (v0[i] / e) * (v0[i] / e);
+		d1 += (f0[i] / e) * (f0[i] / e);
+	}
+	d0 = std::sqrt(d0 / n);
+	d1 = std::sqrt(d1 / n);
+
+	double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+	h0 = std::fmin(h0, h_max);
+	for (std::size_t i = 0; i < n; i++)
+		v1[i] = v0[i] + h0 * f0[i];
+	call_rhs(f, x0 + h0, v1.data(), f1.data());
+	rhs_calls += 2;
+
+	double d2 = 0;
+	for (std::size_t i = 0; i < n; i++)
+		d2 += ((f1[i] - f0[i]) / e) * ((f1[i] - f0[i]) / e);
+	d2 = std::sqrt(d2 / n) / h0;
+
+	double h1;
+	if (d1 <= 1e-15 && d2 <= 1e-15)
+		h1 = std::fmax(1e-6, h0 * 1e-3);
+	else
+		h1 = pow(0.01 / std::fmax(d1, d2), 1.0 / (order + 1));
+
+	return std::fmin(std::fmin(100 * h0, h1), h_max);
+}
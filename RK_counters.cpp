@@ -0,0 +1,95 @@
+#include "RK_counters.h"
+
+#if RK_4_COUNTERS
+#include <chrono>
+#endif
+
+Solver_counters& Solver_counters::operator+=(const Solver_counters& other) {
+	rhs_calls += other.rhs_calls;
+	attempted += other.attempted;
+	accepted += other.accepted;
+	rejected += other.rejected;
+	decreases += other.decreases;
+	increases += other.increases;
+	endpoint_clamps += other.endpoint_clamps;
+	for (int k = 0; k < (int)Phase::Count; k++)
+		seconds[k] += other.seconds[k];
+	return *this;
+}
+
+Solver_counters Solver_counters::operator-(const Solver_counters& other) const {
+	Solver_counters result = *this;
+	result.rhs_calls -= other.rhs_calls;
+	result.attempted -= other.attempted;
+	result.accepted -= other.accepted;
+	result.rejected -= other.rejected;
+	result.decreases -= other.decreases;
+	result.increases -= other.increases;
+	result.endpoint_clamps -= other.endpoint_clamps;
+	for (int k = 0; k < (int)Phase::Count; k++)
+		result.seconds[k] -= other.seconds[k];
+	return result;
+}
+
+double Solver_counters::total_seconds() const {
+	double total = 0;
+	for (int k = 0; k < (int)Phase::Count; k++)
+		total += seconds[k];
+	return total;
+}
+
+const char* phase_name(Phase phase) {
+	switch (phase) {
+	case Phase::RHS: return "rhs";
+	case Phase::Error: return "error";
+	case Phase::Output: return "output";
+	case Phase::Other: return "other";
+	case Phase::Count: break;
+	}
+	return "";
+}
+
+#if RK_4_COUNTERS
+
+typedef std::chrono::steady_clock Counter_clock;
+
+/*
+*	Counter_state -  ,   (-1 -  )  ,     
+*/
+struct Counter_state {
+	Solver_counters counters;
+	int phase = -1;
+	Counter_clock::time_point since;
+};
+
+static thread_local Counter_state state;
+
+/*
+*	 switch_phase -         phase
+*/
+static int switch_phase(int phase) {
+	Counter_clock::time_point now = Counter_clock::now();
+	if (state.phase >= 0)
+		state.counters.seconds[state.phase] += std::chrono::duration<double>(now - state.since).count();
+	int previous = state.phase;
+	state.phase = phase;
+	state.since = now;
+	return previous;
+}
+
+Solver_counters& solver_counters() {
+	return state.counters;
+}
+
+Solver_counters counters_snapshot() {
+	switch_phase(state.phase);
+	return state.counters;
+}
+
+Phase_timer::Phase_timer(Phase phase) : previous(switch_phase((int)phase)) {}
+
+Phase_timer::~Phase_timer() {
+	switch_phase(previous);
+}
+
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+
+/*
+*	 :   , ,    ,
+*	   , ,   xmax,     
+*	   RK_4_COUNTERS=1 (CMake: -DRK_4_COUNTERS=ON);    RK_COUNT  RK_PHASE
+*	,  counters_snapshot  ,      
+*	     
+*/
+#ifndef RK_4_COUNTERS
+#define RK_4_COUNTERS 0
+#endif
+
+const bool Counters_enabled = RK_4_COUNTERS != 0;
+
+/*
+*	Phase -  ,    
+*	RHS -   , Error -       ,
+*	Output -  ,    , Other -  ( ,   )
+*	      (       RHS)
+*/
+enum class Phase { RHS, Error, Output, Other, Count };
+
+struct Solver_counters {
+	std::size_t rhs_calls = 0;			//    (  -   )
+	std::size_t attempted = 0;			//     
+	std::size_t accepted = 0;
+	std::size_t rejected = 0;
+	std::size_t decreases = 0;			//   ( Halving - ,   )
+	std::size_t increases = 0;			//     
+	std::size_t endpoint_clamps = 0;	// , ,     xmax
+	double seconds[(int)Phase::Count] = {};
+
+	Solver_counters& operator+=(const Solver_counters& other);
+	Solver_counters operator-(const Solver_counters& other) const;
+	double total_seconds() const;
+};
+
+const char* phase_name(Phase phase);
+
+#if RK_4_COUNTERS
+
+/*
+*	 solver_counters -   
+*	 counters_snapshot -         
+*/
+Solver_counters& solver_counters();
+Solver_counters counters_snapshot();
+
+/*
+*	Phase_timer -          phase (     )
+*/
+class Phase_timer {
+public:
+	explicit Phase_timer(Phase phase);
+	~Phase_timer();
+	Phase_timer(const Phase_timer&) = delete;
+	Phase_timer& operator=(const Phase_timer&) = delete;
+
+private:
+	int previous;
+};
+
+#define RK_COUNT(field, n) (solver_counters().field += (n))
+#define RK_PHASE_NAME2(line) rk_phase_timer_##line
+#define RK_PHASE_NAME(line) RK_PHASE_NAME2(line)
+#define RK_PHASE(phase) Phase_timer RK_PHASE_NAME(__LINE__)(phase)
+
+#else
+
+inline Solver_counters counters_snapshot() { return Solver_counters(); }
+
+#define RK_COUNT(field, n) ((void)0)
+#define RK_PHASE(phase) ((void)0)
+
+#endif
+
+/*
+*	 call_rhs -    f(args...)     
+*	(       ;  RK_4_COUNTERS -   f)
+*/
+template <class F, class... Args>
+inline decltype(auto) call_rhs(F& f, Args&&... args) {
+	RK_COUNT(rhs_calls, 1);
+	RK_PHASE(Phase::RHS);
+	return f(std::forward<Args>(args)...);
+}
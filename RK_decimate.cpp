@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include "RK_decimate.h"
+
+const char* decimation_name(Decimation decimation) {
+	switch (decimation) {
+	case Decimation::None: return "none";
+	case Decimation::MinMax: return "minmax";
+	case Decimation::LTTB: return "lttb";
+	}
+	return "";
+}
+
+bool parse_decimation(const std::string& name, Decimation& decimation) {
+	const Decimation modes[] = { Decimation::None, Decimation::MinMax, Decimation::LTTB };
+	for (Decimation mode : modes)
+		if (name == decimation_name(mode)) {
+			decimation = mode;
+			return true;
+		}
+	return false;
+}
+
+Decimator::Decimator(std::size_t buckets) : buckets(std::max<std::size_t>(buckets, 1)) {
+	groups.reserve(2 * this->buckets + 1);
+}
+
+void Decimator::merge(Bucket& to, const Bucket& from) {
+	to.last = from.last;
+	if (from.min_x.value < to.min_x.value) to.min_x = from.min_x;
+	if (from.max_x.value > to.max_x.value) to.max_x = from.max_x;
+	if (from.min_y.value < to.min_y.value) to.min_y = from.min_y;
+	if (from.max_y.value > to.max_y.value) to.max_y = from.max_y;
+}
+
+void Decimator::push(double x, double y) {
+	Bucket point = { count, count, { count, x }, { count, x }, { count, y }, { count, y } };
+	count++;
+	if (!groups.empty() && groups.back().last - groups.back().first + 1 < bucket_size) {
+		merge(groups.back(), point);
+		return;
+	}
+	groups.push_back(point);
+	if (groups.size() <= 2 * buckets)
+		return;
+
+	//    -   
+	std::size_t merged = 0;
+	for (std::size_t k = 0; k < groups.size(); k += 2) {
+		groups[merged] = groups[k];
+		if (k + 1 < groups.size())
+			merge(groups[merged], groups[k + 1]);
+		merged++;
+	}
+	groups.resize(merged);
+	bucket_size *= 2;
+}
+
+void Decimator::clear() {
+	groups.clear();
+	bucket_size = 1;
+	count = 0;
+}
+
+std::vector<std::size_t> Decimator::indices() const {
+	std::vector<std::size_t> result;
+	result.reserve(groups.size() * 6);
+	for (const Bucket& group : groups) {
+		std::size_t kept[6] = { group.first, group.min_x.index, group.max_x.index, group.min_y.index, group.max_y.index, group.last };
+		std::sort(kept, kept + 6);
+		for (std::size_t k = 0; k < 6; k++)
+			if (result.empty() || kept[k] != result.back())
+				result.push_back(kept[k]);
+	}
+	return result;
+}
+
+std::vector<std::size_t> decimate_lttb(const double* x, const double* y, const std::vector<std::size_t>& candidates, std::size_t threshold) {
+	const std::size_t n = candidates.size();
+	if (threshold >= n || threshold < 3)
+		return candidates;
+
+	std::vector<std::size_t> result;
+	result.reserve(threshold);
+	result.push_back(candidates[0]);
+	//     ,  n - 2   threshold - 2 
+	const double every = (double)(n - 2) / (threshold - 2);
+	std::size_t a = 0;
+	for (std::size_t bucket = 0; bucket < threshold - 2; bucket++) {
+		std::size_t begin = static_cast<std::size_t>(std::floor(bucket * every)) + 1;
+		std::size_t end = static_cast<std::size_t>(std::floor((bucket + 1) * every)) + 1;
+		std::size_t next_end = std::min(static_cast<std::size_t>(std::floor((bucket + 2) * every)) + 1, n);
+
+		//     (   -  )
+		double avg_x = 0, avg_y = 0;
+		if (end >= n - 1) {
+			avg_x = x[candidates[n - 1]];
+			avg_y = y[candidates[n - 1]];
+		}
+		else {
+			for (std::size_t k = end; k < next_end; k++) {
+				avg_x += x[candidates[k]];
+				avg_y += y[candidates[k]];
+			}
+			avg_x /= next_end - end;
+			avg_y /= next_end - end;
+		}
+
+		const double ax = x[candidates[a]], ay = y[candidates[a]];
+		double max_area = -1;
+		std::size_t chosen = begin;
+		for (std::size_t k = begin; k < end && k < n - 1; k++) {
+			double area = std::abs((ax - avg_x) * (y[candidates[k]] - ay) - (ax - x[candidates[k]]) * (avg_y - ay));
+			if (area > max_area) {
+				max_area = area;
+				chosen = k;
+			}
+		}
+		result.push_back(candidates[chosen]);
+		a = chosen;
+	}
+	result.push_back(candidates[n - 1]);
+	return result;
+}
+
+std::vector<std::size_t> decimate(const double* x, const double* y, std::size_t count, Decimation mode, std::size_t width) {
+	if (mode == Decimation::None || count <= 2 * width) {
+		std::vector<std::size_t> all(count);
+		for (std::size_t k = 0; k < count; k++)
+			all[k] = k;
+		return all;
+	}
+	Decimator decimator(width);
+	for (std::size_t k = 0; k < count; k++)
+		decimator.push(x[k], y[k]);
+	if (mode == Decimation::MinMax)
+		return decimator.indices();
+	return decimate_lttb(x, y, decimator.indices(), 2 * width);
+}
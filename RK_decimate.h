@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+*	Decimation -   
+*	None -  
+*	MinMax -        ,     
+*	           x  y (    )
+*	LTTB - Largest-Triangle-Three-Buckets:     ,     
+*/
+enum class Decimation { None, MinMax, LTTB };
+
+/*
+*	 decimation_name -   ("none", "minmax", "lttb")
+*	 parse_decimation -   ,  false,   
+*/
+const char* decimation_name(Decimation decimation);
+bool parse_decimation(const std::string& name, Decimation& decimation);
+
+/*
+*	 Decimator -  MinMax  ,    (  )
+*	     bucket_size  ;     2 * buckets,
+*	    bucket_size ,      
+*	    ,     buckets (   )
+*	std::size_t buckets -   
+*/
+class Decimator {
+public:
+	explicit Decimator(std::size_t buckets = 1024);
+
+	/*
+	*	 push -    (  -  ,   )
+	*/
+	void push(double x, double y);
+	void clear();
+	std::size_t size() const { return count; }
+
+	/*
+	*	 indices -     
+	*/
+	std::vector<std::size_t> indices() const;
+
+private:
+	struct Extreme {
+		std::size_t index;
+		double value;
+	};
+	struct Bucket {
+		std::size_t first, last;
+		Extreme min_x, max_x, min_y, max_y;
+	};
+	static void merge(Bucket& to, const Bucket& from);
+
+	std::size_t buckets;
+	std::size_t bucket_size = 1;
+	std::size_t count = 0;
+	std::vector<Bucket> groups;
+};
+
+/*
+*	 decimate_lttb -  threshold   candidates,  LTTB
+*	const double* x, y -  
+*	const std::vector<std::size_t>& candidates -     
+*/
+std::vector<std::size_t> decimate_lttb(const double* x, const double* y, const std::vector<std::size_t>& candidates, std::size_t threshold);
+
+/*
+*	 decimate -    (x[k], y[k]), k < count,       width 
+*	(LTTB  2 * width    MinMax,        ,  )
+*/
+std::vector<std::size_t> decimate(const double* x, const double* y, std::size_t count, Decimation mode, std::size_t width);
@@ -0,0 +1,15 @@
+#include "RK_dense.h"
+
+std::vector<double> uniform_grid(double xmin, double xmax, double step) {
+	std::vector<double> grid;
+	if (!(step > 0) || xmax < xmin)
+		return grid;
+	//    xmin + i * step,     
+	std::size_t count = static_cast<std::size_t>(std::floor((xmax - xmin) / step * (1 + 1e-12)));
+	grid.reserve(count + 2);
+	for (std::size_t i = 0; i <= count; i++)
+		grid.push_back(std::fmin(xmin + i * step, xmax));
+	if (grid.back() < xmax)
+		grid.push_back(xmax);
+	return grid;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "RK_4_system.h"
+
+/*
+*	 hermite -      [x_n, x_n + h_n] (   RK4)
+*	double t -  , 0 <= t <= 1
+*	double h_n - 
+*	const State<N>& v0, f0 -  v      x_n
+*	const State<N>& v1, f1 -  v      x_n + h_n
+*	State<N>& v -  v   x_n + t h_n
+*/
+template <std::size_t N>
+void hermite(double t, double h_n, const State<N>& v0, const State<N>& f0, const State<N>& v1, const State<N>& f1, State<N>& v) {
+	const double h00 = (1 + 2 * t) * (1 - t) * (1 - t);
+	const double h10 = t * (1 - t) * (1 - t);
+	const double h01 = t * t * (3 - 2 * t);
+	const double h11 = t * t * (t - 1);
+	for (std::size_t i = 0; i < v0.size(); i++)
+		v[i] = h00 * v0[i] + h10 * h_n * f0[i] + h01 * v1[i] + h11 * h_n * f1[i];
+}
+
+/*
+*	 Hermite_dense -     RK4
+*	           dense  set_step,
+*	         
+*	F f -     f(x, v, dv) (Scalar_rhs, System_call,   Function_2, )
+*	std::size_t n -   (   N = Dynamic)
+*/
+template <std::size_t N, class F>
+class Hermite_dense {
+public:
+	typedef State<N> state_type;
+
+	Hermite_dense(F f, std::size_t n = N)
+		: f(f), v0(make_state<N>(n)), f0(make_state<N>(n)), v1(make_state<N>(n)), f1(make_state<N>(n)) {}
+
+	/*
+	*	 set_step -     (x_n, v_n)   (x_n + h_n, v_next)
+	*/
+	void set_step(double x_n, double h_n, const state_type& v_n, const state_type& v_next) {
+		bool chained = ready && x_n == x1 && v_n == v1;
+		if (chained)
+			f0 = f1;
+		start_ready = chained;
+		ready = false;
+		x0 = x_n;
+		x1 = x_n + h_n;
+		h = h_n;
+		v0 = v_n;
+		v1 = v_next;
+	}
+
+	/*
+	*	 dense -  v   x_n + t h_n  
+	*/
+	void dense(double t, state_type& v) {
+		if (!ready) {
+			if (!start_ready) {
+				call_rhs(f, x0, v0.data(), f0.data());
+				rhs_calls++;
+			}
+			call_rhs(f, x1, v1.data(), f1.data());
+			rhs_calls++;
+			ready = true;
+		}
+		hermite<N>(t, h, v0, f0, v1, f1, v);
+	}
+
+	std::size_t rhs_calls = 0;	//    
+
+private:
+	F f;
+	double x0 = NAN, x1 = NAN, h = 0;
+	bool ready = false, start_ready = false;
+	state_type v0, f0, v1, f1;
+};
+
+/*
+*	 uniform_grid -  save_at   step  xmin  xmax (xmax    )
+*/
+std::vector<double> uniform_grid(double xmin, double xmax, double step);
@@ -0,0 +1,311 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "RK_4_system.h"
+#include "RK_controller.h"
+
+/*
+*	Method -   
+*	RK4 -    4 ,       (RK_4_OLP)
+*	BS32 -    -  3(2)
+*	DP54 -    -  5(4)
+*	DOP853 -   -  8     5  3 
+*	ROS3 - L-   3(2)     (RK_stiff.h)
+*	SDIRK4 -      4(3)  -     (RK_stiff.h)
+*	AUTO - DP54    ROS3      (RK_switch.h)
+*	ABM -   -  -  PECE      12   RK4 (RK_adams.h)
+*	GBS -    -  -    (RK_extrapolation.h)
+*/
+enum class Method { RK4, BS32, DP54, DOP853, ROS3, SDIRK4, AUTO, ABM, GBS };
+
+/*
+*	 method_name -   ("rk4", "bs32", "dp54", "dop853", "ros3", "sdirk4", "auto", "abm", "gbs")
+*	 parse_method -   ,  false,   
+*	 is_stiff -    (ROS3, SDIRK4)
+*/
+const char* method_name(Method method);
+bool parse_method(const std::string& name, Method& method);
+bool is_stiff(Method method);
+
+/*
+*	Embedded_tableau -    
+*	int stages -   s
+*	int order -   
+*	int error_order -    (      e / 2^(error_order + 1))
+*	const double* c, a, b -  (s),  (s x s  )     (s)
+*	const double* e -    (s + 1,  -  f(x + h, v_next))
+*	const double* e3 -    DOP853 (s + 1)  nullptr
+*	int dense_terms, const double* p -   v(x_n + t h) = v_n + h sum_j k_j sum_m p[j][m] t^(m+1),
+*	                                   p -  (s + 1) x dense_terms  
+*	int extra_stages, const double* c_extra, a_extra, d -   DOP853:  
+*	                                   (a_extra - extra_stages   s + 1 + extra_stages)   d (4    )
+*/
+struct Embedded_tableau {
+	int stages;
+	int order;
+	int error_order;
+	const double* c;
+	const double* a;
+	const double* b;
+	const double* e;
+	const double* e3;
+	int dense_terms;
+	const double* p;
+	int extra_stages;
+	const double* c_extra;
+	const double* a_extra;
+	const double* d;
+};
+
+/*
+*	 embedded_tableau -    BS32, DP54  DOP853 (   - DP54)
+*/
+const Embedded_tableau& embedded_tableau(Method method);
+
+/*
+*	 Embedded_stepper -          N
+*	  f(x + h, v_next)     k1  ,
+*	     ,     k1   
+*	(DP54 - 6     , BS32 - 3, DOP853 - 12)
+*	Method method - BS32, DP54  DOP853
+*	F f -     f(x, v, dv) (Scalar_rhs, System_call,   Function_2, )
+*	std::size_t n -   (   N = Dynamic)
+*/
+template <std::size_t N, class F>
+class Embedded_stepper {
+public:
+	typedef State<N> state_type;
+	static const std::size_t dimension = N;
+
+	Embedded_stepper(Method method, F f, std::size_t n = N)
+		: tableau(embedded_tableau(method)), f(f), n(N == Dynamic ? n : N),
+		K(tableau.stages + 1 + tableau.extra_stages, make_state<N>(n)), D(tableau.d != nullptr ? 7 : 0, make_state<N>(n)), tmp(make_state<N>(n)),
+		v_k1(make_state<N>(n)), v_last(make_state<N>(n)), k_last(make_state<N>(n)) {}
+
+	std::size_t size() const { return n; }
+
+	/*
+	*	 error_order -   
+	*/
+	int error_order() const { return tableau.error_order; }
+
+	/*
+	*	 step -  
+	*	double x_n -    
+	*	double h_n -    
+	*	const state_type& v_n -  v   
+	*	state_type& v_next -  v   x_n + h_n ( )
+	*	state_type& v_hat -  v   x_n + h_n ( ), |v_next - v_hat| -   
+	*	(v_next  v_hat     v_n)
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		const int s = tableau.stages;
+		first_stage(x_n, v_n);
+
+		for (int j = 1; j < s; j++) {
+			const double* a = tableau.a + j * s;
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int l = 0; l < j; l++)
+					sum += a[l] * K[l][i];
+				tmp[i] = v_n[i] + h_n * sum;
+			}
+			call_rhs(f, x_n + tableau.c[j] * h_n, tmp.data(), K[j].data());
+		}
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0;
+			for (int l = 0; l < s; l++)
+				sum += tableau.b[l] * K[l][i];
+			v_next[i] = v_n[i] + h_n * sum;
+		}
+		call_rhs(f, x_n + h_n, v_next.data(), K[s].data());
+		rhs_calls += s;
+		if (tableau.c[s - 1] == 1) {
+			//    f(x + h, v_next) -    x: |dk| / |dv|   |lambda| ( )
+			double dk = 0, dv = 0;
+			for (std::size_t i = 0; i < n; i++) {
+				dk = std::fmax(dk, std::abs(K[s][i] - K[s - 1][i]));
+				dv = std::fmax(dv, std::abs(v_next[i] - tmp[i]));
+			}
+			stiffness = dv > 0 ? h_n * dk / dv : 0;
+		}
+
+		for (std::size_t i = 0; i < n; i++) {
+			double err = 0;
+			for (int l = 0; l <= s; l++)
+				err += tableau.e[l] * K[l][i];
+			err *= h_n;
+			if (tableau.e3 != nullptr) {
+				double err3 = 0;
+				for (int l = 0; l <= s; l++)
+					err3 += tableau.e3[l] * K[l][i];
+				err3 *= h_n;
+				double denom = std::hypot(std::abs(err), 0.1 * std::abs(err3));
+				if (denom > 0)
+					err = err * std::abs(err) / denom;
+			}
+			v_hat[i] = v_next[i] - err;
+		}
+
+		x_last = x_n + h_n;
+		h_last = h_n;
+		v_last = v_next;
+		k_last = K[s];
+		dense_ready = false;
+	}
+
+	/*
+	*	 dense -     [x_n, x_n + h_n]
+	*	( DOP853       3  )
+	*	double t -  , v(x_n + t h_n), 0 <= t <= 1
+	*	state_type& v -  v   x_n + t h_n
+	*/
+	void dense(double t, state_type& v) {
+		const int s = tableau.stages;
+		if (tableau.d == nullptr) {
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int j = 0; j <= s; j++) {
+					const double* p = tableau.p + j * tableau.dense_terms;
+					double w = 0;
+					for (int m = tableau.dense_terms - 1; m >= 0; m--)
+						w = (w + p[m]) * t;
+					sum += w * K[j][i];
+				}
+				v[i] = v_k1[i] + h_last * sum;
+			}
+			return;
+		}
+
+		if (!dense_ready)
+			prepare_dense();
+		for (std::size_t i = 0; i < n; i++) {
+			double y = 0;
+			for (int j = 6; j >= 0; j--) {
+				y += D[j][i];
+				y *= (6 - j) % 2 == 0 ? t : 1 - t;
+			}
+			v[i] = v_k1[i] + y;
+		}
+	}
+
+	const Embedded_tableau& tableau;
+	std::size_t rhs_calls = 0;	//    
+	double stiffness = 0;		//  h |lambda|   (DP54, DOP853;     3.3)
+
+private:
+	/*
+	*	 prepare_dense -       DOP853
+	*/
+	void prepare_dense() {
+		const int s = tableau.stages;
+		const int row = s + 1 + tableau.extra_stages;
+		for (int j = 0; j < tableau.extra_stages; j++) {
+			const double* a = tableau.a_extra + j * row;
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int l = 0; l <= s + j; l++)
+					sum += a[l] * K[l][i];
+				tmp[i] = v_k1[i] + h_last * sum;
+			}
+			call_rhs(f, x_k1 + tableau.c_extra[j] * h_last, tmp.data(), K[s + 1 + j].data());
+		}
+		rhs_calls += tableau.extra_stages;
+
+		for (std::size_t i = 0; i < n; i++) {
+			double dv = v_last[i] - v_k1[i];
+			D[0][i] = dv;
+			D[1][i] = h_last * K[0][i] - dv;
+			D[2][i] = 2 * dv - h_last * (K[s][i] + K[0][i]);
+			for (int m = 0; m < 4; m++) {
+				const double* d = tableau.d + m * row;
+				double sum = 0;
+				for (int l = 0; l < row; l++)
+					sum += d[l] * K[l][i];
+				D[3 + m][i] = h_last * sum;
+			}
+		}
+		dense_ready = true;
+	}
+
+	/*
+	*	 first_stage -  k1 = f(x_n, v_n):    ,      ,
+	*	        
+	*/
+	void first_stage(double x_n, const state_type& v_n) {
+		if (x_n == x_last && v_n == v_last)
+			K[0] = k_last;
+		else if (!(x_n == x_k1 && v_n == v_k1)) {
+			call_rhs(f, x_n, v_n.data(), K[0].data());
+			rhs_calls++;
+		}
+		x_k1 = x_n;
+		v_k1 = v_n;
+	}
+
+	F f;
+	std::size_t n;
+	std::vector<state_type> K, D;	//      DOP853
+	state_type tmp;
+	double x_k1 = NAN;
+	state_type v_k1;
+	double x_last = NAN;
+	double h_last = 0;
+	bool dense_ready = false;
+	state_type v_last, k_last;
+};
+
+/*
+*	 RK_embedded_OLP -      
+*	   S = max|v_next - v_hat|,    control
+*	( ,   RK_4_OLP, -    S > e     S < e / 2^(error_order + 1))
+*	   OLP_step (v -  , v_2h -  )
+*	Stepper& stepper - Embedded_stepper  Explicit_stepper  
+*	double x0 -    
+*	const state_type& u0 -  v   
+*	double h -    
+*	double e -   
+*	Step_controller* control -  
+*/
+template <class Stepper>
+OLP_step<Stepper::dimension> RK_embedded_OLP(Stepper& stepper, double x0, const typename Stepper::state_type& u0, double h, double e, Step_controller* control = nullptr) {
+	Step_controller halving;
+	if (control == nullptr)
+		control = &halving;
+	OLP_step<Stepper::dimension> result;
+	result.v = make_state<Stepper::dimension>(stepper.size());
+	result.v_2h = result.v;
+	std::size_t rhs_calls = stepper.rhs_calls;
+	double factor = 1;
+
+	while (true) {
+		result.x_n = x0 + h;
+		stepper.step(x0, h, u0, result.v, result.v_2h);
+		bool accepted;
+		{
+			RK_PHASE(Phase::Error);
+			double S_new = 0;
+			for (std::size_t i = 0; i < stepper.size(); i++)
+				S_new = std::fmax(S_new, std::abs(result.v[i] - result.v_2h[i]));
+			accepted = control->next(S_new / e, stepper.error_order() + 1, factor);
+		}
+		h *= factor;
+		if (accepted) {
+			if (factor > 1)
+				result.swich += 1;
+			break;
+		}
+		result.swich -= 1;
+		if (x0 + h == x0) {
+			result.x_n = x0;
+			result.v = result.v_2h = u0;
+			result.failed = true;
+			break;
+		}
+	}
+	result.h = h;
+	result.rhs_calls = stepper.rhs_calls - rhs_calls;
+	return result;
+}
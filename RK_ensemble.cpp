@@ -0,0 +1,78 @@
+#include <cmath>
+#include <utility>
+#include "RK_counters.h"
+#include "RK_ensemble.h"
+
+const std::size_t L = Ensemble_lanes;
+
+void test_function_batch(double, const double* v, double* dv, const double*) {
+	for (std::size_t l = 0; l < L; l++)
+		dv[l] = -2.5 * v[l];
+}
+
+void function_1_batch(double x, const double* v, double* dv, const double*) {
+	const double c = std::log(x + 1) / (pow(x, 2) + 1);
+	const double s = sin(10 * x);
+	for (std::size_t l = 0; l < L; l++)
+		dv[l] = c * pow(v[l], 2) + v[l] - pow(v[l], 3) * s;
+}
+
+void function_2_batch(double, const double* v, double* dv, const double* coeffs) {
+	const double* u1 = v;
+	const double* u2 = v + L;
+	const double* a = coeffs;
+	const double* b = coeffs + L;
+	for (std::size_t l = 0; l < L; l++) {
+		dv[l] = u2[l];
+		dv[L + l] = -a[l] * pow(u2[l], 2) - b[l] * sin(u1[l]);
+	}
+}
+
+RK_4_ensemble::RK_4_ensemble(Batch_function f, std::size_t n, std::size_t count, std::size_t coeff_count)
+	: f(std::move(f)), n(n), count(count), coeff_count(coeff_count), blocks((count + L - 1) / L),
+	v(blocks * n * L), k(v.size()), sum(v.size()), tmp(v.size()), coeffs(blocks * coeff_count * L) {}
+
+std::size_t RK_4_ensemble::index(std::size_t m, std::size_t j) const {
+	return (m / L * n + j) * L + m % L;
+}
+
+void RK_4_ensemble::set(std::size_t m, const double* v0, const double* c) {
+	for (std::size_t j = 0; j < n; j++)
+		v[index(m, j)] = v0[j];
+	for (std::size_t j = 0; j < coeff_count; j++)
+		coeffs[(m / L * coeff_count + j) * L + m % L] = c[j];
+}
+
+double RK_4_ensemble::value(std::size_t m, std::size_t j) const {
+	return v[index(m, j)];
+}
+
+void RK_4_ensemble::rhs(double x, const std::vector<double>& v_in, std::vector<double>& dv) {
+	RK_COUNT(rhs_calls, count);
+	RK_PHASE(Phase::RHS);
+	for (std::size_t b = 0; b < blocks; b++)
+		f(x, &v_in[b * n * L], &dv[b * n * L], coeffs.empty() ? nullptr : &coeffs[b * coeff_count * L]);
+	rhs_calls += count;
+}
+
+void RK_4_ensemble::step(double x_n, double h_n) {
+	const std::size_t size = v.size();
+	rhs(x_n, v, k);
+	for (std::size_t i = 0; i < size; i++) {
+		sum[i] = k[i];
+		tmp[i] = v[i] + h_n / 2.0 * k[i];
+	}
+	rhs(x_n + h_n / 2.0, tmp, k);
+	for (std::size_t i = 0; i < size; i++) {
+		sum[i] += 2.0 * k[i];
+		tmp[i] = v[i] + h_n / 2.0 * k[i];
+	}
+	rhs(x_n + h_n / 2.0, tmp, k);
+	for (std::size_t i = 0; i < size; i++) {
+		sum[i] += 2.0 * k[i];
+		tmp[i] = v[i] + h_n * k[i];
+	}
+	rhs(x_n + h_n, tmp, k);
+	for (std::size_t i = 0; i < size; i++)
+		v[i] += h_n * (sum[i] + k[i]) / 6.0;
+}
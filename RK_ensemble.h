@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/*
+*	Ensemble_lanes -      
+*	(8  double -   AVX-512    AVX2)
+*/
+const std::size_t Ensemble_lanes = 8;
+
+/*
+*	Batch_rhs -     n    Ensemble_lanes 
+*	   : v[j * Ensemble_lanes + l] -  j  l 
+*	double x -     (   )
+*	const double* v -  v  (n * Ensemble_lanes)
+*	double* dv -  (n * Ensemble_lanes)
+*	const double* coeffs -        (  2 - a,  b)
+*/
+typedef void(*Batch_rhs)(double x, const double* v, double* dv, const double* coeffs);
+
+/*
+*	Batch_function -            Batch_rhs
+*	(, Rhs_program::eval_batch   );    ,    
+*/
+typedef std::function<void(double x, const double* v, double* dv, const double* coeffs)> Batch_function;
+
+/*
+*	 *_batch -    ,  1   2   
+*	(,    x,  function_1_batch     )
+*	  ,   Test_function, Function_1  Function_2,      ,
+*	      
+*/
+void test_function_batch(double x, const double* v, double* dv, const double* coeffs);
+void function_1_batch(double x, const double* v, double* dv, const double* coeffs);
+void function_2_batch(double x, const double* v, double* dv, const double* coeffs);
+
+/*
+*	 RK_4_ensemble -    4      
+*	     
+*	    Ensemble_lanes (AoSoA),        ,
+*	    -    ,   
+*	Batch_function f -      (Batch_rhs   )
+*	std::size_t n -  
+*	std::size_t count -  
+*	std::size_t coeff_count -   
+*/
+class RK_4_ensemble {
+public:
+	RK_4_ensemble(Batch_function f, std::size_t n, std::size_t count, std::size_t coeff_count = 0);
+
+	std::size_t size() const { return count; }
+	std::size_t dimension() const { return n; }
+
+	/*
+	*	 set -   v0 (n )   coeffs (coeff_count )  m
+	*	 value -  j  m
+	*/
+	void set(std::size_t m, const double* v0, const double* coeffs = nullptr);
+	double value(std::size_t m, std::size_t j) const;
+
+	/*
+	*	 step -  h_n     x_n
+	*/
+	void step(double x_n, double h_n);
+
+	std::size_t rhs_calls = 0;	//     ( )
+
+private:
+	/*
+	*	 rhs -     
+	*/
+	void rhs(double x, const std::vector<double>& v_in, std::vector<double>& dv);
+	std::size_t index(std::size_t m, std::size_t j) const;
+
+	Batch_function f;
+	std::size_t n;
+	std::size_t count;
+	std::size_t coeff_count;
+	std::size_t blocks;
+	std::vector<double> v, k, sum, tmp, coeffs;
+};
@@ -0,0 +1,25 @@
+#include "RK_explicit.h"
+
+const char* scheme_name(Scheme scheme) {
+	switch (scheme) {
+	case Scheme::RK4: return "rk4";
+	case Scheme::RK38: return "rk38";
+	case Scheme::Ralston: return "ralston";
+	case Scheme::Heun: return "heun";
+	}
+	return "";
+}
+
+bool parse_scheme(const std::string& name, Scheme& scheme) {
+	const Scheme schemes[] = { Scheme::RK4, Scheme::RK38, Scheme::Ralston, Scheme::Heun };
+	for (Scheme s : schemes)
+		if (name == scheme_name(s)) {
+			scheme = s;
+			return true;
+		}
+	return false;
+}
+
+int scheme_order(Scheme scheme) {
+	return with_scheme(scheme, [](auto tableau) { return decltype(tableau)::order; });
+}
@@ -0,0 +1,397 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include "RK_4_system.h"
+
+/*
+*	   ,      
+*	 -   constexpr-     (    ):
+*	int stages -   s, int order -  
+*	double c[s] -  , c_j = c[j] / a_den[j]
+*	double a[s][s], a_den[s] -  , a_jl = a[j][l] / a_den[j]
+*	double b[s], b_den - , b_l = b[l] / b_den
+*	  (embedded = true)  error_order     b_hat[s], b_hat_den;
+*	fsal = true -    f(x + h, v_next)    k1  
+*	Explicit_stepper    :     ,
+*	    RK4     h / 2 * k1 ... h * (k1 + 2 k2 + 2 k3 + k4) / 6
+*/
+struct Explicit_tableau {
+	static constexpr bool embedded = false;
+	static constexpr bool fsal = false;
+	static constexpr int error_order = 0;
+};
+
+//     4 
+struct Classic_RK4 : Explicit_tableau {
+	static constexpr int stages = 4;
+	static constexpr int order = 4;
+	static constexpr double c[4] = { 0, 1, 1, 1 };
+	static constexpr double a[4][4] = { {}, { 1 }, { 0, 1 }, { 0, 0, 1 } };
+	static constexpr double a_den[4] = { 1, 2, 2, 1 };
+	static constexpr double b[4] = { 1, 2, 2, 1 };
+	static constexpr double b_den = 6;
+};
+
+//  3/8 (  4 )
+struct Three_eighths_RK4 : Explicit_tableau {
+	static constexpr int stages = 4;
+	static constexpr int order = 4;
+	static constexpr double c[4] = { 0, 1, 2, 1 };
+	static constexpr double a[4][4] = { {}, { 1 }, { -1, 3 }, { 1, -1, 1 } };
+	static constexpr double a_den[4] = { 1, 3, 3, 1 };
+	static constexpr double b[4] = { 1, 3, 3, 1 };
+	static constexpr double b_den = 8;
+};
+
+//   2  (    )
+struct Ralston_RK2 : Explicit_tableau {
+	static constexpr int stages = 2;
+	static constexpr int order = 2;
+	static constexpr double c[2] = { 0, 2 };
+	static constexpr double a[2][2] = { {}, { 2 } };
+	static constexpr double a_den[2] = { 1, 3 };
+	static constexpr double b[2] = { 1, 3 };
+	static constexpr double b_den = 4;
+};
+
+//   2  (  )
+struct Heun_RK2 : Explicit_tableau {
+	static constexpr int stages = 2;
+	static constexpr int order = 2;
+	static constexpr double c[2] = { 0, 1 };
+	static constexpr double a[2][2] = { {}, { 1 } };
+	static constexpr double a_den[2] = { 1, 1 };
+	static constexpr double b[2] = { 1, 1 };
+	static constexpr double b_den = 2;
+};
+
+//    -  2(1)
+struct Heun_Euler_21 : Heun_RK2 {
+	static constexpr bool embedded = true;
+	static constexpr int error_order = 1;
+	static constexpr double b_hat[2] = { 1, 0 };
+	static constexpr double b_hat_den = 1;
+};
+
+//    -  3(2),   - f(x + h, v_next)
+struct Bogacki_Shampine_32 : Explicit_tableau {
+	static constexpr bool embedded = true;
+	static constexpr bool fsal = true;
+	static constexpr int stages = 4;
+	static constexpr int order = 3;
+	static constexpr int error_order = 2;
+	static constexpr double c[4] = { 0, 1, 3, 9 };
+	static constexpr double a[4][4] = { {}, { 1 }, { 0, 3 }, { 2, 3, 4 } };
+	static constexpr double a_den[4] = { 1, 2, 4, 9 };
+	static constexpr double b[4] = { 2, 3, 4, 0 };
+	static constexpr double b_den = 9;
+	static constexpr double b_hat[4] = { 7, 6, 8, 3 };
+	static constexpr double b_hat_den = 24;
+};
+
+/*
+*	Scheme -       ( 1, 5, 6)
+*	RK4 -     4 , RK38 -  3/8,
+*	Ralston, Heun -   2 
+*	 scheme_name -   ("rk4", "rk38", "ralston", "heun")
+*	 parse_scheme -   ,  false,   
+*	 scheme_order -  
+*/
+enum class Scheme { RK4, RK38, Ralston, Heun };
+
+const char* scheme_name(Scheme scheme);
+bool parse_scheme(const std::string& name, Scheme& scheme);
+int scheme_order(Scheme scheme);
+
+/*
+*	 with_scheme -  run(Tableau())     scheme
+*	(  -    ,      )
+*/
+template <class Run>
+decltype(auto) with_scheme(Scheme scheme, Run run) {
+	switch (scheme) {
+	case Scheme::RK38: return run(Three_eighths_RK4());
+	case Scheme::Ralston: return run(Ralston_RK2());
+	case Scheme::Heun: return run(Heun_RK2());
+	case Scheme::RK4: break;
+	}
+	return run(Classic_RK4());
+}
+
+/*
+*	 Explicit_stepper -         Tableau    N
+*	   ,     
+*	F f -     f(x, v, dv) (System_call, Scalar_rhs,   Function_2, )
+*	std::size_t n -   (   N = Dynamic)
+*	  -  System_rhs   (coeffs   f  )
+*/
+template <class Tableau, std::size_t N, class F = System_call>
+class Explicit_stepper {
+public:
+	typedef State<N> state_type;
+	typedef Tableau tableau_type;
+	static const std::size_t dimension = N;
+	static const int stages = Tableau::stages;
+	static const int order = Tableau::order;
+
+	explicit Explicit_stepper(F f, std::size_t n = N)
+		: f(f), n(N == Dynamic ? n : N), tmp(make_state<N>(n)), v_k1(make_state<N>(n)), v_last(make_state<N>(n)), k_last(make_state<N>(n)) {
+		for (state_type& k : K)
+			k = make_state<N>(n);
+	}
+
+	Explicit_stepper(System_rhs rhs, const double* coeffs, std::size_t n = N)
+		: Explicit_stepper(F{ rhs, coeffs }, n) {}
+
+	std::size_t size() const { return n; }
+
+	/*
+	*	 error_order -    ( RK_embedded_OLP)
+	*/
+	static constexpr int error_order() { return Tableau::error_order; }
+
+	/*
+	*	 step -    
+	*	double x_n -    
+	*	double h_n -    
+	*	const state_type& v_n -  v   
+	*	state_type& v_next -  v   x_n + h_n (   v_n)
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next) {
+		x_k1 = NAN;
+		rhs(x_n, v_n, K[0]);
+		stages_from<1>(x_n, h_n, v_n);
+		combine(h_n, v_n, v_next);
+		rhs_calls += stages;
+	}
+
+	/*
+	*	 step_doubling -  h_n    h_n / 2       
+	*	 k1        ,     3s - 1 
+	*	    
+	*	state_type& v_h -  v   x_n + h_n,    
+	*	state_type& v_2h -  v   x_n + h_n,       
+	*	(v_h  v_2h     v_n)
+	*/
+	std::size_t step_doubling(double x_n, double h_n, const state_type& v_n, state_type& v_h, state_type& v_2h) {
+		x_k1 = NAN;
+		rhs(x_n, v_n, K[0]);
+		stages_from<1>(x_n, h_n, v_n);
+		combine(h_n, v_n, v_h);
+		stages_from<1>(x_n, h_n / 2.0, v_n);
+		combine(h_n / 2.0, v_n, v_2h);
+		rhs(x_n + h_n / 2.0, v_2h, K[0]);
+		stages_from<1>(x_n + h_n / 2.0, h_n / 2.0, v_2h);
+		combine(h_n / 2.0, v_2h, v_2h);
+		rhs_calls += 3 * stages - 1;
+		return 3 * stages - 1;
+	}
+
+	/*
+	*	 step_doubling_nodes -  ,   step_doubling(x_n, h_n, ...)   ,
+	*	        (   , RK_split.h)
+	*	double* x - 3s - 1 
+	*	 3s - 1
+	*/
+	static std::size_t step_doubling_nodes(double x_n, double h_n, double* x) {
+		std::size_t count = 0;
+		x[count++] = x_n;
+		nodes_from<1>(x_n, h_n, x, count);
+		nodes_from<1>(x_n, h_n / 2.0, x, count);
+		x[count++] = x_n + h_n / 2.0;
+		nodes_from<1>(x_n + h_n / 2.0, h_n / 2.0, x, count);
+		return count;
+	}
+
+	/*
+	*	 step -     ( Embedded_stepper  RK_embedded_OLP)
+	*	state_type& v_next -  , state_type& v_hat -  
+	*	(v_next  v_hat     v_n)
+	*	 k1      ,   fsal      
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		static_assert(Tableau::embedded, "step with v_hat needs an embedded pair");
+		if (Tableau::fsal && x_n == x_last && v_n == v_last)
+			K[0] = k_last;
+		else if (!(x_n == x_k1 && v_n == v_k1)) {
+			rhs(x_n, v_n, K[0]);
+			rhs_calls++;
+		}
+		x_k1 = x_n;
+		v_k1 = v_n;
+		stages_from<1>(x_n, h_n, v_n);
+		combine(h_n, v_n, v_next);
+		for (std::size_t i = 0; i < n; i++)
+			v_hat[i] = v_n[i] + scale<(int)Tableau::b_hat_den>(h_n, hat_sum(i, std::make_integer_sequence<int, stages>()));
+		rhs_calls += stages - 1;
+		if constexpr (Tableau::fsal) {
+			x_last = x_n + h_n;
+			v_last = v_next;
+			k_last = K[stages - 1];
+		}
+	}
+
+	std::size_t rhs_calls = 0;	//    
+
+private:
+	void rhs(double x, const state_type& v, state_type& dv) {
+		call_rhs(f, x, v.data(), dv.data());
+	}
+
+	/*
+	*	 scale - h * sum / den (   den = 1)
+	*/
+	template <int Den>
+	static double scale(double h, double sum) {
+		if constexpr (Den == 1)
+			return h * sum;
+		else
+			return h * sum / Den;
+	}
+
+	/*
+	*	 add_* -       (   )
+	*	   -0.0,       
+	*/
+	template <int J, int L>
+	void add_a(double& sum, std::size_t i) const {
+		if constexpr (Tableau::a[J][L] != 0)
+			sum += Tableau::a[J][L] * K[L][i];
+	}
+
+	template <int L>
+	void add_b(double& sum, std::size_t i) const {
+		if constexpr (Tableau::b[L] != 0)
+			sum += Tableau::b[L] * K[L][i];
+	}
+
+	template <int L>
+	void add_b_hat(double& sum, std::size_t i) const {
+		if constexpr (Tableau::b_hat[L] != 0)
+			sum += Tableau::b_hat[L] * K[L][i];
+	}
+
+	template <int J, int... L>
+	double row_sum(std::size_t i, std::integer_sequence<int, L...>) const {
+		double sum = -0.0;
+		(add_a<J, L>(sum, i), ...);
+		return sum;
+	}
+
+	template <int... L>
+	double weight_sum(std::size_t i, std::integer_sequence<int, L...>) const {
+		double sum = -0.0;
+		(add_b<L>(sum, i), ...);
+		return sum;
+	}
+
+	template <int... L>
+	double hat_sum(std::size_t i, std::integer_sequence<int, L...>) const {
+		double sum = -0.0;
+		(add_b_hat<L>(sum, i), ...);
+		return sum;
+	}
+
+	/*
+	*	 stage_x -    J: x_n + c_J h_n
+	*/
+	template <int J>
+	static double stage_x(double x_n, double h_n) {
+		constexpr double c = Tableau::c[J];
+		constexpr double den = Tableau::a_den[J];
+		if constexpr (c == 0)
+			return x_n;
+		else if constexpr (c == den)
+			return x_n + h_n;
+		else if constexpr (c == 1)
+			return x_n + h_n / den;
+		else
+			return x_n + h_n * c / den;
+	}
+
+	/*
+	*	 stages_from -  J ... s     0 ... J - 1
+	*/
+	template <int J>
+	void stages_from(double x_n, double h_n, const state_type& v_n) {
+		if constexpr (J < stages) {
+			for (std::size_t i = 0; i < n; i++)
+				tmp[i] = v_n[i] + scale<(int)Tableau::a_den[J]>(h_n, row_sum<J>(i, std::make_integer_sequence<int, J>()));
+			rhs(stage_x<J>(x_n, h_n), tmp, K[J]);
+			stages_from<J + 1>(x_n, h_n, v_n);
+		}
+	}
+
+	/*
+	*	 nodes_from -    J ... s (  stages_from)
+	*/
+	template <int J>
+	static void nodes_from(double x_n, double h_n, double* x, std::size_t& count) {
+		if constexpr (J < stages) {
+			x[count++] = stage_x<J>(x_n, h_n);
+			nodes_from<J + 1>(x_n, h_n, x, count);
+		}
+	}
+
+	/*
+	*	 combine -    : v_next = v_n + h_n sum b_l k_l (v_next    v_n)
+	*/
+	void combine(double h_n, const state_type& v_n, state_type& v_next) const {
+		for (std::size_t i = 0; i < n; i++)
+			v_next[i] = v_n[i] + scale<(int)Tableau::b_den>(h_n, weight_sum(i, std::make_integer_sequence<int, stages>()));
+	}
+
+	F f;
+	std::size_t n;
+	std::array<state_type, Tableau::stages> K;
+	state_type tmp;
+	double x_k1 = NAN;			// ,     K[0]    
+	state_type v_k1;
+	double x_last = NAN;		//        (fsal)
+	state_type v_last, k_last;
+};
+
+/*
+*	RK_4_stepper -      4     N
+*	(step - 4   , step_doubling - 11)
+*/
+template <std::size_t N, class F = System_call>
+using RK_4_stepper = Explicit_stepper<Classic_RK4, N, F>;
+
+/*
+*	Step_doubling -          
+*	double x_n -    
+*	double v_h -  v,    
+*	double v_2h -  v,       
+*	std::size_t rhs_calls -    
+*/
+struct Step_doubling {
+	double x_n;
+	double v_h;
+	double v_2h;
+	std::size_t rhs_calls;
+};
+
+/*
+*	 explicit_step -   Tableau    f(x, v),  { x_n + h_n, v }
+*	 explicit_step_doubling -  h_n    h_n / 2    (3s - 1   )
+*	F f -    f(x, v) (  ,   )
+*/
+template <class Tableau, class F>
+std::pair<double, double> explicit_step(F f, double h_n, double x_n, double v_n) {
+	Explicit_stepper<Tableau, 1, Scalar_rhs<F>> stepper(Scalar_rhs<F>{ f });
+	State<1> v = { v_n };
+	stepper.step(x_n, h_n, v, v);
+	return { x_n + h_n, v[0] };
+}
+
+template <class Tableau, class F>
+Step_doubling explicit_step_doubling(F f, double h_n, double x_n, double v_n) {
+	Explicit_stepper<Tableau, 1, Scalar_rhs<F>> stepper(Scalar_rhs<F>{ f });
+	State<1> v = { v_n }, v_h{}, v_2h{};
+	std::size_t calls = stepper.step_doubling(x_n, h_n, v, v_h, v_2h);
+	return { x_n + h_n, v_h[0], v_2h[0], calls };
+}
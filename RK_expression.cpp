@@ -0,0 +1,604 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include "RK_expression.h"
+
+/*
+*	 apply -   (          -)
+*/
+static inline double apply(Opcode op, double a, double b) {
+	switch (op) {
+	case Opcode::Add: return a + b;
+	case Opcode::Sub: return a - b;
+	case Opcode::Mul: return a * b;
+	case Opcode::Div: return a / b;
+	case Opcode::Neg: return -a;
+	case Opcode::Pow: return std::pow(a, b);
+	case Opcode::Sqrt: return std::sqrt(a);
+	case Opcode::Exp: return std::exp(a);
+	case Opcode::Log: return std::log(a);
+	case Opcode::Sin: return std::sin(a);
+	case Opcode::Cos: return std::cos(a);
+	case Opcode::Tan: return std::tan(a);
+	case Opcode::Asin: return std::asin(a);
+	case Opcode::Acos: return std::acos(a);
+	case Opcode::Atan: return std::atan(a);
+	case Opcode::Sinh: return std::sinh(a);
+	case Opcode::Cosh: return std::cosh(a);
+	case Opcode::Tanh: return std::tanh(a);
+	case Opcode::Abs: return std::abs(a);
+	case Opcode::Min: return std::fmin(a, b);
+	case Opcode::Max: return std::fmax(a, b);
+	case Opcode::Const: case Opcode::Input: break;
+	}
+	return 0;
+}
+
+/*
+*	 opcode_name -        listing
+*/
+static const char* opcode_name(Opcode op) {
+	switch (op) {
+	case Opcode::Add: return "add";
+	case Opcode::Sub: return "sub";
+	case Opcode::Mul: return "mul";
+	case Opcode::Div: return "div";
+	case Opcode::Neg: return "neg";
+	case Opcode::Pow: return "pow";
+	case Opcode::Sqrt: return "sqrt";
+	case Opcode::Exp: return "exp";
+	case Opcode::Log: return "log";
+	case Opcode::Sin: return "sin";
+	case Opcode::Cos: return "cos";
+	case Opcode::Tan: return "tan";
+	case Opcode::Asin: return "asin";
+	case Opcode::Acos: return "acos";
+	case Opcode::Atan: return "atan";
+	case Opcode::Sinh: return "sinh";
+	case Opcode::Cosh: return "cosh";
+	case Opcode::Tanh: return "tanh";
+	case Opcode::Abs: return "abs";
+	case Opcode::Min: return "min";
+	case Opcode::Max: return "max";
+	case Opcode::Const: return "const";
+	case Opcode::Input: return "input";
+	}
+	return "";
+}
+
+static bool is_binary(Opcode op) {
+	return op == Opcode::Add || op == Opcode::Sub || op == Opcode::Mul || op == Opcode::Div ||
+		op == Opcode::Pow || op == Opcode::Min || op == Opcode::Max;
+}
+
+/*
+*	Expression_graph -      :         
+*	    ( ),       
+*	    ,    -  
+*/
+class Expression_graph {
+public:
+	struct Node {
+		Opcode op;
+		int a;
+		int b;
+		double value;	// Const - , Input -   
+	};
+
+	std::vector<Node> nodes;
+
+	int input(int reg) {
+		return add({ Opcode::Input, -1, -1, (double)reg });
+	}
+
+	int constant(double value) {
+		return add({ Opcode::Const, -1, -1, value });
+	}
+
+	bool is_constant(int node, double value) const {
+		return nodes[node].op == Opcode::Const && nodes[node].value == value && !std::signbit(nodes[node].value) == !std::signbit(value);
+	}
+
+	int unary(Opcode op, int a) {
+		if (nodes[a].op == Opcode::Const)
+			return constant(apply(op, nodes[a].value, 0));
+		if (op == Opcode::Neg && nodes[a].op == Opcode::Neg)
+			return nodes[a].a;
+		return add({ op, a, a, 0 });
+	}
+
+	int binary(Opcode op, int a, int b) {
+		if (nodes[a].op == Opcode::Const && nodes[b].op == Opcode::Const)
+			return constant(apply(op, nodes[a].value, nodes[b].value));
+		switch (op) {
+		case Opcode::Add:
+			if (nodes[b].op == Opcode::Neg)		// a + (-b) = a - b
+				return binary(Opcode::Sub, a, nodes[b].a);
+			if (nodes[a].op == Opcode::Neg)
+				return binary(Opcode::Sub, b, nodes[a].a);
+			break;
+		case Opcode::Sub:
+			if (is_constant(b, 0))
+				return a;
+			if (nodes[b].op == Opcode::Neg)		// a - (-b) = a + b
+				return binary(Opcode::Add, a, nodes[b].a);
+			break;
+		case Opcode::Mul:
+			if (is_constant(a, 1) || is_constant(b, 1))
+				return is_constant(a, 1) ? b : a;
+			if (is_constant(a, -1) || is_constant(b, -1))
+				return unary(Opcode::Neg, is_constant(a, -1) ? b : a);
+			break;
+		case Opcode::Div:
+			if (is_constant(b, 1))
+				return a;
+			if (is_constant(b, -1))
+				return unary(Opcode::Neg, a);
+			if (nodes[b].op == Opcode::Const && nodes[b].value != 0 && std::isfinite(nodes[b].value)) {
+				//     -   ,   
+				int exponent;
+				double mantissa = std::frexp(nodes[b].value, &exponent);
+				if (std::abs(mantissa) == 0.5 && std::isnormal(1 / nodes[b].value))
+					return binary(Opcode::Mul, a, constant(1 / nodes[b].value));
+			}
+			break;
+		case Opcode::Pow:
+			return power(a, b);
+		default:
+			break;
+		}
+		//     ,  a * b  b * a   
+		if ((op == Opcode::Add || op == Opcode::Mul || op == Opcode::Min || op == Opcode::Max) && a > b)
+			std::swap(a, b);
+		return add({ op, a, b, 0 });
+	}
+
+	/*
+	*	 power - a^b:    64 -  (  ),  - 1 / a^|b|,
+	*	b = 0.5 - sqrt,  - pow
+	*/
+	int power(int a, int b) {
+		if (nodes[b].op == Opcode::Const) {
+			double y = nodes[b].value;
+			if (y == 0)
+				return constant(1);
+			if (y == std::floor(y) && std::abs(y) <= 64) {
+				long k = std::labs((long)y);
+				int result = -1;
+				int square = a;
+				while (k > 0) {
+					if (k & 1)
+						result = result < 0 ? square : binary(Opcode::Mul, result, square);
+					k >>= 1;
+					if (k > 0)
+						square = binary(Opcode::Mul, square, square);
+				}
+				return y < 0 ? binary(Opcode::Div, constant(1), result) : result;
+			}
+			if (y == 0.5)
+				return unary(Opcode::Sqrt, a);
+		}
+		return add({ Opcode::Pow, a, b, 0 });
+	}
+
+private:
+	typedef std::tuple<int, int, int, std::uint64_t> Key;
+	std::map<Key, int> index;
+
+	int add(const Node& node) {
+		std::uint64_t bits;
+		std::memcpy(&bits, &node.value, sizeof(bits));
+		Key key((int)node.op, node.a, node.b, bits);
+		auto found = index.find(key);
+		if (found != index.end())
+			return found->second;
+		nodes.push_back(node);
+		index.emplace(key, (int)nodes.size() - 1);
+		return (int)nodes.size() - 1;
+	}
+};
+
+/*
+*	Expression_parser -    
+*	expr = term { (+|-) term }, term = unary { (*|/) unary }, unary = (+|-) unary | power,
+*	power = primary [ (^|**) unary ], primary =  |  | (expr, ...) | (expr)
+*/
+class Expression_parser {
+public:
+	Expression_parser(Expression_graph& graph, const std::string& text, const std::map<std::string, int>& names)
+		: graph(graph), text(text), names(names) {}
+
+	int parse() {
+		int node = expr();
+		skip_spaces();
+		if (pos < text.size())
+			fail("unexpected '" + text.substr(pos, 1) + "'");
+		return node;
+	}
+
+private:
+	Expression_graph& graph;
+	const std::string& text;
+	const std::map<std::string, int>& names;
+	std::size_t pos = 0;
+
+	[[noreturn]] void fail(const std::string& what) const {
+		throw std::invalid_argument("position " + std::to_string(pos + 1) + ": " + what);
+	}
+
+	void skip_spaces() {
+		while (pos < text.size() && std::isspace((unsigned char)text[pos]))
+			pos++;
+	}
+
+	bool accept(const char* token) {
+		skip_spaces();
+		std::size_t length = std::strlen(token);
+		if (text.compare(pos, length, token) != 0)
+			return false;
+		pos += length;
+		return true;
+	}
+
+	void expect(const char* token) {
+		if (!accept(token))
+			fail(std::string("expected '") + token + "'");
+	}
+
+	int expr() {
+		int node = term();
+		while (true) {
+			if (accept("+"))
+				node = graph.binary(Opcode::Add, node, term());
+			else if (accept("-"))
+				node = graph.binary(Opcode::Sub, node, term());
+			else
+				return node;
+		}
+	}
+
+	int term() {
+		int node = unary();
+		while (true) {
+			if (accept("*"))
+				node = graph.binary(Opcode::Mul, node, unary());
+			else if (accept("/"))
+				node = graph.binary(Opcode::Div, node, unary());
+			else
+				return node;
+		}
+	}
+
+	int unary() {
+		if (accept("-"))
+			return graph.unary(Opcode::Neg, unary());
+		if (accept("+"))
+			return unary();
+		int node = primary();
+		if (accept("^") || accept("**"))
+			node = graph.binary(Opcode::Pow, node, unary());
+		return node;
+	}
+
+	int primary() {
+		skip_spaces();
+		if (pos >= text.size())
+			fail("unexpected end of expression");
+		char c = text[pos];
+		if (std::isdigit((unsigned char)c) || c == '.') {
+			const char* begin = text.c_str() + pos;
+			char* end = nullptr;
+			double value = std::strtod(begin, &end);
+			if (end == begin)
+				fail("bad number");
+			pos += end - begin;
+			return graph.constant(value);
+		}
+		if (accept("(")) {
+			int node = expr();
+			expect(")");
+			return node;
+		}
+		if (!(std::isalpha((unsigned char)c) || c == '_'))
+			fail(std::string("unexpected '") + c + "'");
+		std::size_t start = pos;
+		while (pos < text.size() && (std::isalnum((unsigned char)text[pos]) || text[pos] == '_'))
+			pos++;
+		std::string name = text.substr(start, pos - start);
+
+		skip_spaces();
+		if (pos < text.size() && text[pos] == '(') {
+			pos++;
+			std::vector<int> args(1, expr());
+			while (accept(","))
+				args.push_back(expr());
+			expect(")");
+			return call(name, args, start);
+		}
+		auto found = names.find(name);
+		if (found != names.end())
+			return graph.input(found->second);
+		if (name == "pi")
+			return graph.constant(3.14159265358979323846);
+		pos = start;
+		fail("unknown name " + name);
+	}
+
+	int call(const std::string& name, const std::vector<int>& args, std::size_t start) {
+		static const Opcode unary_ops[] = { Opcode::Sqrt, Opcode::Exp, Opcode::Log, Opcode::Sin, Opcode::Cos, Opcode::Tan,
+			Opcode::Asin, Opcode::Acos, Opcode::Atan, Opcode::Sinh, Opcode::Cosh, Opcode::Tanh, Opcode::Abs };
+		static const Opcode binary_ops[] = { Opcode::Pow, Opcode::Min, Opcode::Max };
+		for (Opcode op : unary_ops)
+			if (name == opcode_name(op)) {
+				if (args.size() != 1)
+					break;
+				return graph.unary(op, args[0]);
+			}
+		for (Opcode op : binary_ops)
+			if (name == opcode_name(op)) {
+				if (args.size() != 2)
+					break;
+				return graph.binary(op, args[0], args[1]);
+			}
+		pos = start;
+		fail("unknown function " + name + " with " + std::to_string(args.size()) + " argument(s)");
+	}
+};
+
+bool Rhs_program::compile(const std::vector<std::string>& expressions, const std::vector<std::string>& parameter_names) {
+	*this = Rhs_program();
+	n = expressions.size();
+	parameters = parameter_names.size();
+	if (n == 0) {
+		message = "no expressions";
+		return false;
+	}
+
+	std::map<std::string, int> names;
+	names["x"] = 0;
+	if (n == 1)
+		names["v"] = 1;
+	for (std::size_t j = 0; j < n; j++)
+		names["v" + std::to_string(j + 1)] = (int)(1 + j);
+	for (std::size_t k = 0; k < parameters; k++)
+		names[parameter_names[k]] = (int)(1 + n + k);
+
+	Expression_graph graph;
+	std::vector<int> roots;
+	for (std::size_t j = 0; j < n; j++) {
+		try {
+			roots.push_back(Expression_parser(graph, expressions[j], names).parse());
+		}
+		catch (const std::invalid_argument& ex) {
+			message = "expression " + std::to_string(j + 1) + ", " + ex.what();
+			return false;
+		}
+	}
+
+	//       (   )
+	const std::size_t size = graph.nodes.size();
+	std::vector<bool> live(size, false);
+	std::vector<std::size_t> last_use(size, 0);
+	for (int root : roots) {
+		live[root] = true;
+		last_use[root] = size;
+	}
+	for (std::size_t i = size; i-- > 0; ) {
+		if (!live[i])
+			continue;
+		const Expression_graph::Node& node = graph.nodes[i];
+		if (node.op == Opcode::Const || node.op == Opcode::Input)
+			continue;
+		live[node.a] = live[node.b] = true;
+		last_use[node.a] = std::max(last_use[node.a], i);
+		last_use[node.b] = std::max(last_use[node.b], i);
+	}
+
+	// : , ,   (   )
+	std::vector<int> reg(size, -1);
+	std::size_t next = 1 + n + parameters;
+	for (std::size_t i = 0; i < size; i++) {
+		const Expression_graph::Node& node = graph.nodes[i];
+		if (!live[i])
+			continue;
+		if (node.op == Opcode::Input)
+			reg[i] = (int)node.value;
+		else if (node.op == Opcode::Const) {
+			reg[i] = (int)next++;
+			constants.push_back({ (std::uint16_t)reg[i], node.value });
+		}
+	}
+	std::vector<int> free_regs;
+	for (std::size_t i = 0; i < size; i++) {
+		const Expression_graph::Node& node = graph.nodes[i];
+		if (!live[i] || node.op == Opcode::Const || node.op == Opcode::Input)
+			continue;
+		Instruction ins;
+		ins.op = node.op;
+		ins.a = (std::uint16_t)reg[node.a];
+		ins.b = (std::uint16_t)reg[node.b];
+		// ,     ,     :
+		//   r[a], r[b]   r[dst]     ,   dst    a  b
+		const int args[2] = { node.a, node.b };
+		for (int k = 0; k < (node.a == node.b ? 1 : 2); k++) {
+			const Expression_graph::Node& arg = graph.nodes[args[k]];
+			if (last_use[args[k]] == i && arg.op != Opcode::Const && arg.op != Opcode::Input)
+				free_regs.push_back(reg[args[k]]);
+		}
+		if (free_regs.empty())
+			reg[i] = (int)next++;
+		else {
+			reg[i] = free_regs.back();
+			free_regs.pop_back();
+		}
+		ins.dst = (std::uint16_t)reg[i];
+		instructions.push_back(ins);
+	}
+	count = next;
+	if (count > 65535) {
+		*this = Rhs_program();
+		message = "expression is too large";
+		return false;
+	}
+	for (int root : roots)
+		outputs.push_back((std::uint16_t)reg[root]);
+	return true;
+}
+
+std::vector<double> Rhs_program::registers(const double* params, std::size_t lanes) const {
+	std::vector<double> r(count * lanes, 0.0);
+	for (const std::pair<std::uint16_t, double>& c : constants)
+		std::fill(r.begin() + c.first * lanes, r.begin() + (c.first + 1) * lanes, c.second);
+	if (params != nullptr)
+		for (std::size_t k = 0; k < parameters; k++)
+			std::fill(r.begin() + (1 + n + k) * lanes, r.begin() + (2 + n + k) * lanes, params[k]);
+	return r;
+}
+
+void Rhs_program::eval(double x, const double* v, double* dv, double* r) const {
+	r[0] = x;
+	for (std::size_t j = 0; j < n; j++)
+		r[1 + j] = v[j];
+	for (const Instruction& ins : instructions)
+		r[ins.dst] = apply(ins.op, r[ins.a], r[ins.b]);
+	for (std::size_t j = 0; j < n; j++)
+		dv[j] = r[outputs[j]];
+}
+
+void Rhs_program::eval_batch(double x, const double* v, double* dv, const double* params, std::size_t lanes, double* r) const {
+	std::fill(r, r + lanes, x);
+	std::copy(v, v + n * lanes, r + lanes);
+	if (params != nullptr)
+		std::copy(params, params + parameters * lanes, r + (1 + n) * lanes);
+	for (const Instruction& ins : instructions) {
+		double* d = r + ins.dst * lanes;
+		const double* a = r + ins.a * lanes;
+		const double* b = r + ins.b * lanes;
+		switch (ins.op) {
+		case Opcode::Add:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = a[l] + b[l];
+			break;
+		case Opcode::Sub:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = a[l] - b[l];
+			break;
+		case Opcode::Mul:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = a[l] * b[l];
+			break;
+		case Opcode::Div:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = a[l] / b[l];
+			break;
+		case Opcode::Neg:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = -a[l];
+			break;
+		default:
+			for (std::size_t l = 0; l < lanes; l++)
+				d[l] = apply(ins.op, a[l], b[l]);
+			break;
+		}
+	}
+	for (std::size_t j = 0; j < n; j++)
+		std::copy(r + outputs[j] * lanes, r + (outputs[j] + 1) * lanes, dv + j * lanes);
+}
+
+std::string Rhs_program::listing() const {
+	std::ostringstream out;
+	out.precision(17);
+	out << "r0 = x";
+	for (std::size_t j = 0; j < n; j++)
+		out << ", r" << 1 + j << " = v" << 1 + j;
+	for (std::size_t k = 0; k < parameters; k++)
+		out << ", r" << 1 + n + k << " = parameter " << 1 + k;
+	out << "\n";
+	for (const std::pair<std::uint16_t, double>& c : constants)
+		out << "r" << c.first << " = " << c.second << "\n";
+	for (const Instruction& ins : instructions) {
+		out << "r" << ins.dst << " = " << opcode_name(ins.op) << " r" << ins.a;
+		if (is_binary(ins.op))
+			out << ", r" << ins.b;
+		out << "\n";
+	}
+	for (std::size_t j = 0; j < n; j++)
+		out << "dv" << 1 + j << " = r" << outputs[j] << "\n";
+	return out.str();
+}
+
+/*
+*	 cpp_operation -  -    C++   a  b
+*/
+static std::string cpp_operation(Opcode op, const std::string& a, const std::string& b) {
+	switch (op) {
+	case Opcode::Add: return a + " + " + b;
+	case Opcode::Sub: return a + " - " + b;
+	case Opcode::Mul: return a + " * " + b;
+	case Opcode::Div: return a + " / " + b;
+	case Opcode::Neg: return "-" + a;
+	case Opcode::Pow: return "std::pow(" + a + ", " + b + ")";
+	case Opcode::Abs: return "std::abs(" + a + ")";
+	case Opcode::Min: return "std::fmin(" + a + ", " + b + ")";
+	case Opcode::Max: return "std::fmax(" + a + ", " + b + ")";
+	default: return std::string("std::") + opcode_name(op) + "(" + a + ")";
+	}
+}
+
+/*
+*	 cpp_constant -     C++ (  NaN     )
+*/
+static std::string cpp_constant(double value) {
+	if (std::isnan(value))
+		return "NAN";
+	if (std::isinf(value))
+		return value > 0 ? "HUGE_VAL" : "-HUGE_VAL";
+	std::ostringstream out;
+	out << std::hexfloat << value;
+	return out.str();
+}
+
+std::string Rhs_program::source() const {
+	std::ostringstream out;
+	const std::size_t first_temp = 1 + n + parameters + constants.size();
+	out << "#include <cmath>\n#include <cstddef>\n\n";
+	out << "// " << n << " equation(s), " << parameters << " parameter(s), " << instructions.size() << " operation(s)\n";
+	out << "static inline void rhs(double r0, const double* v, double* dv, const double* p, std::size_t s) {\n";
+	for (std::size_t j = 0; j < n; j++)
+		out << "\tconst double r" << 1 + j << " = v[" << j << " * s];\n";
+	for (std::size_t k = 0; k < parameters; k++)
+		out << "\tconst double r" << 1 + n + k << " = p[" << k << " * s];\n";
+	for (const std::pair<std::uint16_t, double>& c : constants)
+		out << "\tconst double r" << c.first << " = " << cpp_constant(c.second) << ";\n";
+	for (std::size_t i = first_temp; i < count; i++)
+		out << "\tdouble r" << i << ";\n";
+	for (const Instruction& ins : instructions)
+		out << "\tr" << ins.dst << " = " << cpp_operation(ins.op, "r" + std::to_string(ins.a), "r" + std::to_string(ins.b)) << ";\n";
+	for (std::size_t j = 0; j < n; j++)
+		out << "\tdv[" << j << " * s] = r" << outputs[j] << ";\n";
+	out << "}\n\n";
+	out << "extern \"C\" void rk_4_rhs(double x, const double* v, double* dv, const double* p) {\n"
+		"\trhs(x, v, dv, p, 1);\n}\n\n";
+	out << "extern \"C\" void rk_4_rhs_batch(double x, const double* v, double* dv, const double* p, std::size_t lanes) {\n"
+		"\tfor (std::size_t l = 0; l < lanes; l++)\n"
+		"\t\trhs(x, v + l, dv + l, p == nullptr ? nullptr : p + l, lanes);\n}\n";
+	return out.str();
+}
+
+std::vector<std::string> split_expressions(const std::string& text) {
+	std::vector<std::string> parts;
+	std::size_t start = 0;
+	while (true) {
+		std::size_t end = text.find(';', start);
+		parts.push_back(text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+		if (end == std::string::npos)
+			return parts;
+		start = end + 1;
+	}
+}
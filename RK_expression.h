@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+*	Opcode -  -  
+*	Add ... Max -    a  b (   a)
+*	Const, Input -  ,    :    
+*/
+enum class Opcode : std::uint8_t {
+	Add, Sub, Mul, Div, Neg, Pow, Sqrt, Exp, Log, Sin, Cos, Tan, Asin, Acos, Atan, Sinh, Cosh, Tanh, Abs, Min, Max,
+	Const, Input
+};
+
+/*
+*	Instruction -  r[dst] = op(r[a], r[b]) (8 )
+*/
+struct Instruction {
+	Opcode op;
+	std::uint16_t dst;
+	std::uint16_t a;
+	std::uint16_t b;
+};
+
+/*
+*	 Rhs_program -     n,  :    
+*	 - ,  x, v ( n = 1), v1 ... vn,   , pi,
+*	 + - * / ^ ( **),  sqrt exp log sin cos tan asin acos atan sinh cosh tanh abs pow min max
+*	,  1: "log(x+1)/(x^2+1)*v^2 + v - v^3*sin(10*x)"
+*	   ,     ,
+*	    (x^3 = x^2 * x),     - ,
+*	     -:  r[0] = x, r[1 ... n] = v,  ,
+*	    (     )
+*	  compile  ,       ,
+*	    (registers)
+*/
+class Rhs_program {
+public:
+	/*
+	*	 compile -    
+	*	 false,     ( - error(),    )
+	*	const std::vector<std::string>& expressions -  dv1 ... dvn
+	*	const std::vector<std::string>& parameters -   (  2 - { "a", "b" })
+	*/
+	bool compile(const std::vector<std::string>& expressions, const std::vector<std::string>& parameters = {});
+	const std::string& error() const { return message; }
+
+	std::size_t dimension() const { return n; }
+	std::size_t parameter_count() const { return parameters; }
+	std::size_t register_count() const { return count; }
+	const std::vector<Instruction>& code() const { return instructions; }
+
+	/*
+	*	 registers -   eval (lanes = 1)  eval_batch (lanes   )
+	*	     (const double* params - parameter_count()   nullptr)
+	*/
+	std::vector<double> registers(const double* params = nullptr, std::size_t lanes = 1) const;
+
+	/*
+	*	 eval -    : dv = f(x, v)
+	*	double* r -  (registers)
+	*/
+	void eval(double x, const double* v, double* dv, double* r) const;
+
+	/*
+	*	 eval_batch -    lanes  ,   -   
+	*	   : v[j * lanes + l] -  j  l (  RK_4_ensemble)
+	*	const double* params -       (params[k * lanes + l])  nullptr,
+	*	     
+	*	double* r -  (registers    lanes)
+	*/
+	void eval_batch(double x, const double* v, double* dv, const double* params, std::size_t lanes, double* r) const;
+
+	/*
+	*	 listing - -    (   )
+	*/
+	std::string listing() const;
+
+	/*
+	*	 source - -     C++ ( RK_native.h): 
+	*	extern "C" void rk_4_rhs(double x, const double* v, double* dv, const double* p) -  eval, p - 
+	*	extern "C" void rk_4_rhs_batch(double x, const double* v, double* dv, const double* p, std::size_t lanes) -  eval_batch
+	*	    ,    ( )
+	*/
+	std::string source() const;
+
+private:
+	std::size_t n = 0;
+	std::size_t parameters = 0;
+	std::size_t count = 0;							//  
+	std::vector<Instruction> instructions;
+	std::vector<std::pair<std::uint16_t, double>> constants;	//    
+	std::vector<std::uint16_t> outputs;				//  dv1 ... dvn
+	std::string message;
+};
+
+/*
+*	Program_rhs -    Rhs_program      :
+*	f(x, v)     f(x, v, dv)  
+*	 (Rhs_program::registers)  ;   (  )
+*	    ,         
+*/
+struct Program_rhs {
+	const Rhs_program* program;
+	double* r;
+
+	double operator()(double x, double v) const {
+		double dv;
+		program->eval(x, &v, &dv, r);
+		return dv;
+	}
+
+	void operator()(double x, const double* v, double* dv) const {
+		program->eval(x, v, dv, r);
+	}
+};
+
+/*
+*	 split_expressions -     ,  ';'
+*/
+std::vector<std::string> split_expressions(const std::string& text);
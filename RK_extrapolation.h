@@ -0,0 +1,177 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include "RK_4_system.h"
+#include "RK_dense.h"
+
+/*
+*	 Extrapolation_stepper -     -  - 
+*	(, ͸, , II.9,   ODEX)       1e-12  
+*	 j:      n_j = 2j  h / n_j (n_j - 1   ,
+*	f(x_n, v_n)    ),      (h / n_j)^2
+*	  - : T_(j,l+1) = T_(j,l) + (T_(j,l) - T_(j-1,l)) / ((n_j / n_(j-l))^2 - 1)
+*	  k : v_next = T_(k,k)  2k, v_hat = T_(k,k-1),   |T_(k,k) - T_(k,k-1)|
+*	 2k - 2;    RK_embedded_OLP
+*	  k = 3 ... Max_rows          
+*	A_j / h_j,  A_j -      j , h_j - ,  
+*	 |T_(j,j) - T_(j,j-1)|    tolerance;  k -  tolerance
+*	  -   ; f   ,   ,
+*	  f(x_n, v_n)  
+*	F f -     f(x, v, dv) (Scalar_rhs, System_call,   Function_2, )
+*	std::size_t n -   (   N = Dynamic)
+*/
+template <std::size_t N, class F>
+class Extrapolation_stepper {
+public:
+	typedef State<N> state_type;
+	static const std::size_t dimension = N;
+	static const int Max_rows = 9;
+
+	Extrapolation_stepper(F f, std::size_t n = N)
+		: f(f), n(N == Dynamic ? n : N), f0(make_state<N>(n)), f1(make_state<N>(n)), v_start(make_state<N>(n)),
+		v_end(make_state<N>(n)), y_previous(make_state<N>(n)), y(make_state<N>(n)), dy(make_state<N>(n)) {
+		for (state_type& t : T)
+			t = make_state<N>(n);
+	}
+
+	std::size_t size() const { return n; }
+
+	/*
+	*	 error_order -    T_(k,k-1): 2k - 2
+	*/
+	int error_order() const { return 2 * (rows > 0 ? rows : initial_rows()) - 2; }
+
+	/*
+	*	 step -   ( Embedded_stepper  RK_embedded_OLP)
+	*	state_type& v_next - T_(k,k), state_type& v_hat - T_(k,k-1) (v_next  v_hat     v_n)
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		if (rows == 0)
+			rows = initial_rows();
+		const bool accepted = x_n == x_end && v_n == v_end;
+		if (accepted)
+			accept();
+		if (accepted && end_ready)
+			f0 = f1;
+		else if (!(x_n == x_start && v_n == v_start)) {
+			call_rhs(f, x_n, v_n.data(), f0.data());
+			rhs_calls++;
+		}
+		x_start = x_n;
+		v_start = v_n;
+		x_end = x_n + h_n;
+		h = h_n;
+		end_ready = false;
+
+		for (int j = 1; j <= rows; j++) {
+			midpoint(x_n, h_n, v_n, 2 * j);
+			//  j : T[l] - T_(j-1,l+1)   T_(j,l+1)
+			for (std::size_t i = 0; i < n; i++) {
+				double t = y[i];
+				for (int l = 1; l < j; l++) {
+					const double ratio = double(j) / (j - l);
+					const double next = t + (t - T[l - 1][i]) / (ratio * ratio - 1);
+					T[l - 1][i] = t;
+					t = next;
+				}
+				T[j - 1][i] = t;
+			}
+			if (j >= 2) {
+				errors[j] = 0;
+				for (std::size_t i = 0; i < n; i++)
+					errors[j] = std::fmax(errors[j], std::abs(T[j - 1][i] - T[j - 2][i]));
+			}
+		}
+		v_next = T[rows - 1];
+		v_hat = T[rows - 2];
+		v_end = v_next;
+	}
+
+	/*
+	*	 dense -       (  f   )
+	*	double t -  , 0 <= t <= 1
+	*/
+	void dense(double t, state_type& v) {
+		if (!end_ready) {
+			call_rhs(f, x_end, v_end.data(), f1.data());
+			rhs_calls++;
+			end_ready = true;
+		}
+		hermite<N>(t, h, v_start, f0, v_end, f1, v);
+	}
+
+	double tolerance = 1e-6;	//    (   )
+	std::size_t rhs_calls = 0;	//    
+	int rows = 0;				//   k   (0 -    )
+
+private:
+	/*
+	*	 initial_rows -      (ODEX: 0.6 |lg tolerance| + 1.5)
+	*/
+	int initial_rows() const {
+		const int k = (int)(-std::log10(tolerance) * 0.6 + 1.5);
+		return k < 3 ? 3 : (k > Max_rows - 1 ? Max_rows - 1 : k);
+	}
+
+	/*
+	*	 midpoint -    : m  h_n / m,   y
+	*	(y_1 = v_n + H f(x_n, v_n), y_(i+1) = y_(i-1) + 2 H f(x_n + i H, y_i))
+	*/
+	void midpoint(double x_n, double h_n, const state_type& v_n, int m) {
+		const double H = h_n / m;
+		for (std::size_t i = 0; i < n; i++) {
+			y_previous[i] = v_n[i];
+			y[i] = v_n[i] + H * f0[i];
+		}
+		for (int step = 1; step < m; step++) {
+			call_rhs(f, x_n + step * H, y.data(), dy.data());
+			for (std::size_t i = 0; i < n; i++) {
+				const double next = y_previous[i] + 2 * H * dy[i];
+				y_previous[i] = y[i];
+				y[i] = next;
+			}
+		}
+		rhs_calls += m - 1;
+	}
+
+	/*
+	*	 work -      j : 1 + sum_(i<=j) (n_i - 1) = j^2 + 1
+	*/
+	static double work(int j) { return double(j) * j + 1; }
+
+	/*
+	*	 step_work -     A_j / h_j  j      
+	*/
+	double step_work(int j) const {
+		double factor = Max_factor;
+		if (errors[j] > 0)
+			factor = std::fmin(Max_factor, std::fmax(Min_factor, 0.94 * pow(0.65 * tolerance / errors[j], 1.0 / (2 * j - 1))));
+		return work(j) / (h * factor);
+	}
+
+	/*
+	*	 accept -    :     
+	*	(,    k - 1   ,  -   k  ,   k - 1)
+	*/
+	void accept() {
+		const double lower = step_work(rows - 1), current = step_work(rows);
+		if (rows > 3 && lower < 0.8 * current)
+			rows--;
+		else if (rows < Max_rows && current < 0.9 * lower)
+			rows++;
+	}
+
+	static constexpr double Min_factor = 0.02;
+	static constexpr double Max_factor = 4;
+
+	F f;
+	std::size_t n;
+	state_type f0, f1;				// f       
+	double x_start = NAN, x_end = NAN, h = 0;
+	state_type v_start, v_end;
+	bool end_ready = false;
+	state_type y_previous, y, dy;
+	std::array<state_type, Max_rows> T;	//   
+	double errors[Max_rows + 1] = {};	// |T_(j,j) - T_(j,j-1)|  
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RK_4_system.h"
+
+/*
+*	Square_matrix<N> -  N x N  : std::array   , std::vector  N = Dynamic
+*/
+template <std::size_t N>
+using Square_matrix = std::conditional_t<N == Dynamic, std::vector<double>, std::array<double, N * N>>;
+
+/*
+*	 Dense_LU - LU-  n x n      
+*	(  :  I - h gamma J   1 - 50)
+*	 N != Dynamic            
+*	   data()   (a[i * n + j]),  factor    solve
+*	std::size_t n -  (   N = Dynamic)
+*/
+template <std::size_t N>
+class Dense_LU {
+public:
+	explicit Dense_LU(std::size_t n = N) : n(N == Dynamic ? n : N) {
+		if constexpr (N == Dynamic) {
+			a.assign(n * n, 0.0);
+			pivot.assign(n, 0);
+		}
+	}
+
+	std::size_t size() const { return n; }
+	double* data() { return a.data(); }
+
+	/*
+	*	 factor -  PA = LU   
+	*	 false,    (   )
+	*/
+	bool factor() {
+		for (std::size_t k = 0; k < n; k++) {
+			std::size_t p = k;
+			for (std::size_t i = k + 1; i < n; i++)
+				if (std::abs(a[i * n + k]) > std::abs(a[p * n + k]))
+					p = i;
+			pivot[k] = p;
+			if (a[p * n + k] == 0)
+				return false;
+			if (p != k)
+				for (std::size_t j = 0; j < n; j++)
+					std::swap(a[k * n + j], a[p * n + j]);
+			const double inverse = 1 / a[k * n + k];
+			for (std::size_t i = k + 1; i < n; i++) {
+				const double l = a[i * n + k] * inverse;
+				a[i * n + k] = l;
+				if (l != 0)
+					for (std::size_t j = k + 1; j < n; j++)
+						a[i * n + j] -= l * a[k * n + j];
+			}
+		}
+		return true;
+	}
+
+	/*
+	*	 solve -  Ax = b   factor (b   x)
+	*/
+	void solve(double* b) const {
+		for (std::size_t k = 0; k < n; k++)
+			if (pivot[k] != k)
+				std::swap(b[k], b[pivot[k]]);
+		for (std::size_t i = 1; i < n; i++) {
+			double sum = b[i];
+			for (std::size_t j = 0; j < i; j++)
+				sum -= a[i * n + j] * b[j];
+			b[i] = sum;
+		}
+		for (std::size_t i = n; i-- > 0; ) {
+			double sum = b[i];
+			for (std::size_t j = i + 1; j < n; j++)
+				sum -= a[i * n + j] * b[j];
+			b[i] = sum / a[i * n + i];
+		}
+	}
+
+private:
+	std::size_t n;
+	Square_matrix<N> a{};
+	std::conditional_t<N == Dynamic, std::vector<std::size_t>, std::array<std::size_t, N>> pivot{};
+};
@@ -0,0 +1,190 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "RK_native.h"
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char* const Native_flags = "-std=c++17 -O3 -fPIC -shared";
+
+/*
+*	 environment -      
+*/
+static std::string environment(const char* name) {
+	const char* value = std::getenv(name);
+	return value != nullptr ? value : "";
+}
+
+/*
+*	 fnv1a - 64-  FNV-1a (   )
+*/
+static std::uint64_t fnv1a(const std::string& text) {
+	std::uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : text) {
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/*
+*	 cache_directory -   (RK_4_CACHE, $XDG_CACHE_HOME/rk_4, $HOME/.cache/rk_4)
+*/
+static std::string cache_directory() {
+	std::string dir = environment("RK_4_CACHE");
+	if (!dir.empty())
+		return dir;
+	dir = environment("XDG_CACHE_HOME");
+	if (!dir.empty())
+		return dir + "/rk_4";
+	dir = environment("HOME");
+	if (!dir.empty())
+		return dir + "/.cache/rk_4";
+	return "/tmp/rk_4";
+}
+
+/*
+*	 quote -       
+*/
+static std::string quote(const std::string& path) {
+	std::string result = "'";
+	for (char c : path) {
+		if (c == '\'')
+			result += "'\\''";
+		else
+			result += c;
+	}
+	return result + "'";
+}
+
+/*
+*	 read_file -   ( )   
+*/
+static std::string read_file(const std::string& path) {
+	std::ifstream in(path);
+	std::ostringstream text;
+	text << in.rdbuf();
+	return text.str();
+}
+
+Native_rhs_library::~Native_rhs_library() {
+	unload();
+}
+
+#ifdef _WIN32
+
+bool Native_rhs_library::load(const Rhs_program&) {
+	unload();
+	message = "native right-hand sides are not supported on Windows";
+	return false;
+}
+
+void Native_rhs_library::unload() {
+	f = nullptr;
+	f_batch = nullptr;
+}
+
+#else
+
+/*
+*	 make_directories -      
+*/
+static bool make_directories(const std::string& dir) {
+	for (std::size_t pos = 1; pos <= dir.size(); pos++) {
+		if (pos < dir.size() && dir[pos] != '/')
+			continue;
+		std::string part = dir.substr(0, pos);
+		if (::mkdir(part.c_str(), 0755) != 0 && errno != EEXIST)
+			return false;
+	}
+	return true;
+}
+
+bool Native_rhs_library::load(const Rhs_program& program) {
+	unload();
+	message.clear();
+	n = program.dimension();
+	parameters = program.parameter_count();
+
+	std::string compiler = environment("RK_4_CXX");
+	if (compiler.empty())
+		compiler = environment("CXX");
+	if (compiler.empty())
+		compiler = "c++";
+	const std::string source = program.source();
+	char name[32];
+	std::snprintf(name, sizeof(name), "rhs_%016llx", (unsigned long long)fnv1a(compiler + " " + Native_flags + "\n" + source));
+
+	const std::string dir = cache_directory();
+	const std::string base = dir + "/" + name;
+	library = base + ".so";
+	from_cache = ::access(library.c_str(), R_OK) == 0;
+	if (from_cache)
+		handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (handle == nullptr) {
+		//     :      ,
+		//       
+		from_cache = false;
+		if (!make_directories(dir)) {
+			message = "cannot create the cache directory " + dir;
+			return false;
+		}
+		const std::string temp = base + "." + std::to_string(::getpid());
+		{
+			std::ofstream out(temp + ".cpp");
+			out << source;
+			if (!out) {
+				message = "cannot write " + temp + ".cpp";
+				return false;
+			}
+		}
+		const std::string command = compiler + " " + Native_flags + " -o " + quote(temp + ".so") + " " + quote(temp + ".cpp") +
+			" > " + quote(temp + ".log") + " 2>&1";
+		const int status = std::system(command.c_str());
+		if (status != 0) {
+			message = "compiler failed: " + command + "\n" + read_file(temp + ".log");
+			std::remove((temp + ".so").c_str());
+			std::remove((temp + ".cpp").c_str());
+			std::remove((temp + ".log").c_str());
+			return false;
+		}
+		std::remove((temp + ".log").c_str());
+		std::rename((temp + ".cpp").c_str(), (base + ".cpp").c_str());
+		if (std::rename((temp + ".so").c_str(), library.c_str()) != 0) {
+			message = "cannot write " + library;
+			return false;
+		}
+		handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (handle == nullptr) {
+			const char* reason = ::dlerror();
+			message = "cannot load " + library + ": " + (reason != nullptr ? reason : "");
+			return false;
+		}
+	}
+
+	f = reinterpret_cast<Native_function>(::dlsym(handle, "rk_4_rhs"));
+	f_batch = reinterpret_cast<Native_batch_function>(::dlsym(handle, "rk_4_rhs_batch"));
+	if (f == nullptr || f_batch == nullptr) {
+		message = library + " does not export rk_4_rhs";
+		unload();
+		return false;
+	}
+	return true;
+}
+
+void Native_rhs_library::unload() {
+	if (handle != nullptr)
+		::dlclose(handle);
+	handle = nullptr;
+	f = nullptr;
+	f_batch = nullptr;
+}
+
+#endif
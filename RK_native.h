@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "RK_expression.h"
+
+/*
+*	Native_function -     : dv = f(x, v), p - 
+*	Native_batch_function -    lanes   (    Rhs_program::eval_batch)
+*/
+typedef void (*Native_function)(double x, const double* v, double* dv, const double* p);
+typedef void (*Native_batch_function)(double x, const double* v, double* dv, const double* p, std::size_t lanes);
+
+/*
+*	 Native_rhs_library - Rhs_program,   C++ (Rhs_program::source), 
+*	        
+*	          ,   
+*	       
+*	  -   RK_4_CACHE,  $XDG_CACHE_HOME/rk_4,  $HOME/.cache/rk_4
+*	 - RK_4_CXX,  CXX,  c++
+*	   POSIX- (dlopen);  Windows load  false
+*/
+class Native_rhs_library {
+public:
+	Native_rhs_library() = default;
+	Native_rhs_library(const Native_rhs_library&) = delete;
+	Native_rhs_library& operator=(const Native_rhs_library&) = delete;
+	~Native_rhs_library();
+
+	/*
+	*	 load -  (   )     program
+	*	 false,           ( - error())
+	*/
+	bool load(const Rhs_program& program);
+	const std::string& error() const { return message; }
+
+	std::size_t dimension() const { return n; }
+	std::size_t parameter_count() const { return parameters; }
+	Native_function function() const { return f; }
+	Native_batch_function batch() const { return f_batch; }
+
+	const std::string& path() const { return library; }	//    
+	bool cached() const { return from_cache; }				//      (  )
+
+private:
+	void unload();
+
+	void* handle = nullptr;
+	Native_function f = nullptr;
+	Native_batch_function f_batch = nullptr;
+	std::size_t n = 0;
+	std::size_t parameters = 0;
+	std::string library;
+	bool from_cache = false;
+	std::string message;
+};
+
+/*
+*	Native_rhs -    Native_rhs_library      :
+*	f(x, v)     f(x, v, dv)  
+*	const double* p -  (Native_rhs_library::parameter_count ),  ,   
+*/
+struct Native_rhs {
+	Native_function f;
+	const double* p;
+
+	double operator()(double x, double v) const {
+		double dv;
+		f(x, &v, &dv, p);
+		return dv;
+	}
+
+	void operator()(double x, const double* v, double* dv) const {
+		f(x, v, dv, p);
+	}
+};
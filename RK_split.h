@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "RK_explicit.h"
+
+/*
+*	    : f(x, v) = g(c(x), v),  c(x)    x
+*	(  1 - log(x + 1) / (x^2 + 1)  sin(10 x)).  F   
+*	static const std::size_t coefficient_count -  
+*	static void coefficients(const double* x, double* c, std::size_t count) -    count ,
+*		c[k * count + i] -  k   x[i] (      )
+*	double state_terms(const double* c, double v) const - g(c, v)    
+*	          Coefficient_table
+*/
+template <class F, class = void>
+struct is_split_rhs : std::false_type {};
+
+template <class F>
+struct is_split_rhs<F, std::void_t<decltype(F::coefficient_count)>> : std::true_type {};
+
+/*
+*	Split_block -  ,       
+*/
+const std::size_t Split_block = 256;
+
+/*
+*	 Coefficient_table -     F,  
+*	    ;   (  ,     ,
+*	     )   
+*	     ,    -   
+*/
+template <class F>
+class Coefficient_table {
+public:
+	static const std::size_t m = F::coefficient_count;
+
+	/*
+	*	 fill_step_doubling -    explicit_step_doubling<Tableau>  
+	*	x, x + h, ...,  x <= x_max,    steps 
+	*	x   ,     (x += h),      
+	*/
+	template <class Tableau>
+	void fill_step_doubling(double x, double h, double x_max, std::size_t steps) {
+		typedef Explicit_stepper<Tableau, 1, Scalar_rhs<F>> Stepper;
+		const std::size_t per_step = 3 * Tableau::stages - 1;
+		calls.resize(steps * per_step);
+		index.resize(steps * per_step);
+		unique.resize(steps * per_step);
+		std::size_t count = 0, distinct = 0;
+		for (std::size_t k = 0; k < steps && x <= x_max; k++, x += h) {
+			const std::size_t n = Stepper::step_doubling_nodes(x, h, calls.data() + count);
+			for (std::size_t j = count; j < count + n; j++) {
+				//  -      ( ,     )
+				std::size_t l = distinct;
+				while (l > 0 && l + Lookback > distinct && unique[l - 1] != calls[j])
+					l--;
+				if (l == 0 || l + Lookback == distinct) {
+					unique[distinct] = calls[j];
+					l = ++distinct;
+				}
+				index[j] = (std::uint32_t)(l - 1);
+			}
+			count += n;
+		}
+		calls.resize(count);
+		c.resize(m * distinct);
+		F::coefficients(unique.data(), c.data(), distinct);
+		stride = distinct;
+		next = 0;
+	}
+
+	/*
+	*	 find -   ,     x (coeffs - m )
+	*	 false,  x      
+	*/
+	bool find(double x, double* coeffs) {
+		if (next >= calls.size() || calls[next] != x)
+			return false;
+		for (std::size_t k = 0; k < m; k++)
+			coeffs[k] = c[k * stride + index[next]];
+		next++;
+		return true;
+	}
+
+private:
+	static const std::size_t Lookback = 8;
+
+	std::vector<double> calls;			//     
+	std::vector<std::uint32_t> index;	//     
+	std::vector<double> unique;			//  
+	std::vector<double> c;				// : c[k * stride + i] -  k   unique[i]
+	std::size_t stride = 0;
+	std::size_t next = 0;				//  
+};
+
+/*
+*	Split_rhs -    F       f(x, v)
+*	(      ;    ,
+*	   -   )
+*/
+template <class F>
+struct Split_rhs {
+	F f;
+	Coefficient_table<F>* table;
+
+	double operator()(double x, double v) const {
+		double c[F::coefficient_count];
+		if (!table->find(x, c))
+			F::coefficients(&x, c, 1);
+		return f.state_terms(c, v);
+	}
+};
@@ -0,0 +1,64 @@
+#include <cmath>
+#include "RK_stats.h"
+
+void Moments::add(double v) {
+	if (!std::isfinite(v))
+		return;
+	count++;
+	double delta = v - mean;
+	mean += delta / count;
+	m2 += delta * (v - mean);
+}
+
+void Moments::merge(const Moments& other) {
+	if (other.count == 0)
+		return;
+	if (count == 0) {
+		*this = other;
+		return;
+	}
+	double total = static_cast<double>(count + other.count);
+	double delta = other.mean - mean;
+	mean += delta * other.count / total;
+	m2 += other.m2 + delta * delta * ((double)count * other.count / total);
+	count += other.count;
+}
+
+void Log2_histogram::add(double v) {
+	if (!(v > 0))
+		return;
+	int bin = std::ilogb(v) - First;
+	if (bin < 0) bin = 0;
+	if (bin >= Bins) bin = Bins - 1;
+	counts[bin]++;
+}
+
+void Log2_histogram::merge(const Log2_histogram& other) {
+	for (int bin = 0; bin < Bins; bin++)
+		counts[bin] += other.counts[bin];
+}
+
+void Step_stats::add(const Table_row& row, bool has_true_solution) {
+	steps++;
+	max_OLP.add(row.OLP, row.x);
+	max_h.add(row.h, row.x);
+	min_h.add(row.h, row.x);
+	if (has_true_solution)
+		max_u_v.add(row.u_v, row.x);
+	C1_amount += row.C1;
+	C2_amount += row.C2;
+	OLP.add(row.OLP);
+	h.add(row.h);
+}
+
+void Step_stats::merge(const Step_stats& other) {
+	steps += other.steps;
+	max_OLP.merge(other.max_OLP);
+	max_h.merge(other.max_h);
+	min_h.merge(other.min_h);
+	max_u_v.merge(other.max_u_v);
+	C1_amount += other.C1_amount;
+	C2_amount += other.C2_amount;
+	OLP.merge(other.OLP);
+	h.merge(other.h);
+}
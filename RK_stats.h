@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include "RK_trajectory.h"
+
+/*
+*	Extremum -  (Max = true)      x,    
+*	 NaN ,      ( merge -   )
+*/
+template <bool Max>
+struct Extremum {
+	double value = 0;
+	double x = 0;
+	bool found = false;
+
+	void add(double v, double at) {
+		if (v != v)
+			return;
+		if (!found || (Max ? v > value : v < value)) {
+			value = v;
+			x = at;
+			found = true;
+		}
+	}
+
+	void merge(const Extremum& other) {
+		if (other.found)
+			add(other.value, other.x);
+	}
+};
+
+/*
+*	Moments -  ,    ( ,   -  )
+*	   NaN ( )  
+*/
+struct Moments {
+	std::size_t count = 0;
+	double mean = 0;
+	double m2 = 0;			//     
+
+	void add(double v);
+	void merge(const Moments& other);
+	double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+};
+
+/*
+*	Log2_histogram -      :
+*	 e    [2^e, 2^(e+1)), e  First  First + Bins - 1 (  -  ,   )
+*/
+struct Log2_histogram {
+	static const int First = -80;
+	static const int Bins = 96;
+	std::array<std::size_t, Bins> counts{};
+
+	void add(double v);
+	void merge(const Log2_histogram& other);
+	static int exponent(int bin) { return First + bin; }
+};
+
+/*
+*	Step_stats -   ,         
+*	(max||, max h, min h, max|u_i-v_i|   x,     ,
+*	   ,  )
+*	    O(1),   ; merge   
+*	(,  ) ,      
+*/
+struct Step_stats {
+	std::size_t steps = 0;
+	Extremum<true> max_OLP;
+	Extremum<true> max_h;
+	Extremum<false> min_h;
+	Extremum<true> max_u_v;
+	std::size_t C1_amount = 0;		//   
+	std::size_t C2_amount = 0;		//   
+	Moments OLP;
+	Log2_histogram h;
+
+	/*
+	*	 add -    (|u - v| -   has_true_solution)
+	*/
+	void add(const Table_row& row, bool has_true_solution);
+	void merge(const Step_stats& other);
+};
@@ -0,0 +1,402 @@
+#pragma once
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "RK_4_system.h"
+#include "RK_embedded.h"
+#include "RK_lu.h"
+
+/*
+*	    f(x, v, dv)   
+*	void jacobian(double x, const double* v, double* J, double* dfdx) const
+*	J[i * n + j] = df_i / dv_j, dfdx[i] = df_i / dx (Test_function, Function_1, Function_2  Scalar_rhs  )
+*	      : n        df / dx
+*/
+template <class F, class = void>
+struct has_jacobian : std::false_type {};
+
+template <class F>
+struct has_jacobian<F, std::void_t<decltype(std::declval<const F&>().jacobian(0.0, std::declval<const double*>(), std::declval<double*>(), std::declval<double*>()))>> : std::true_type {};
+
+/*
+*	ROS3_coefficients - L-   ROS3 3(2) (  ., 1997)   
+*	(, , . 2, IV.7):
+*	(I / (h gamma) - J) U_i = f(x + alpha_i h, v + sum_j a_ij U_j) + sum_j c_ij U_j / h + gamma_i h df/dx
+*	v_next = v + sum_i m_i U_i,   sum_i e_i U_i (  2 )
+*	J  df/dx    (x, v) ;    f  (new_f = false), 
+*	  2      
+*	dense -   2  v(x + t h) = v + sum_i (t dense[0][i] + t^2 dense[1][i]) U_i
+*/
+struct ROS3_coefficients {
+	static constexpr int stages = 3;
+	static constexpr double gamma = 4.3586652150845899941601945119356e-01;
+	static constexpr double alpha[3] = { 0, 4.3586652150845899941601945119356e-01, 4.3586652150845899941601945119356e-01 };
+	static constexpr double gamma_i[3] = { 4.3586652150845899941601945119356e-01, 2.4291996454816804366592249683314e-01, 2.1851380027664058511513169485832e+00 };
+	static constexpr bool new_f[3] = { false, true, false };
+	static constexpr double a[3][3] = {
+		{ 0, 0, 0 },
+		{ 1, 0, 0 },
+		{ 1, 0, 0 } };
+	static constexpr double c[3][3] = {
+		{ 0, 0, 0 },
+		{ -1.0156171083877702091975600115545e+00, 0, 0 },
+		{ 4.0759956452537699824805835358067e+00, 9.2076794298330791242156818474003e+00, 0 } };
+	static constexpr double m[3] = { 1, 6.1697947043828245592553615689730e+00, -4.2772256543218573326238373806514e-01 };
+	static constexpr double e[3] = { 0.5, -2.9079558716805469821718236208017e+00, 2.2354069897811569627360909276199e-01 };
+	static constexpr double dense[2][3] = {
+		{ 2.40131475255754, 8.6042473194909554, -0.97787698504781362 },
+		{ -1.4013147525575398, -2.4344526151081318, 0.55015441961562783 } };
+};
+
+/*
+*	SDIRK4_coefficients - L-    4(3) (, , . 2, IV.6, (6.16))
+*	  a    b,  v_next -   
+*	b_hat -    3 
+*	dense -   3  v(x + t h) = v + h sum_i (t dense[0][i] + t^2 dense[1][i] + t^3 dense[2][i]) k_i
+*/
+struct SDIRK4_coefficients {
+	static constexpr int stages = 5;
+	static constexpr double gamma = 1.0 / 4;
+	static constexpr double c[5] = { 1.0 / 4, 3.0 / 4, 11.0 / 20, 1.0 / 2, 1 };
+	static constexpr double a[5][5] = {
+		{ 1.0 / 4, 0, 0, 0, 0 },
+		{ 1.0 / 2, 1.0 / 4, 0, 0, 0 },
+		{ 17.0 / 50, -1.0 / 25, 1.0 / 4, 0, 0 },
+		{ 371.0 / 1360, -137.0 / 2720, 15.0 / 544, 1.0 / 4, 0 },
+		{ 25.0 / 24, -49.0 / 48, 125.0 / 16, -85.0 / 12, 1.0 / 4 } };
+	static constexpr double b_hat[5] = { 59.0 / 48, -17.0 / 96, 225.0 / 32, -85.0 / 12, 0 };
+	static constexpr double dense[3][5] = {
+		{ 11083.0 / 5816, -28205.0 / 11632, 4575.0 / 11632, 0, 1637.0 / 1454 },
+		{ 6311.0 / 5816, 113505.0 / 11632, 177625.0 / 11632, -85.0 / 4, -14143.0 / 2908 },
+		{ -34007.0 / 17448, -291523.0 / 34896, -91325.0 / 11632, 85.0 / 6, 2899.0 / 727 } };
+};
+
+/*
+*	 stiff_error_order -      (ROS3 - 2, SDIRK4 - 3)
+*/
+inline int stiff_error_order(Method method) {
+	return method == Method::ROS3 ? 2 : 3;
+}
+
+/*
+*	 Stiff_stepper -    ROS3  SDIRK4    N
+*	(  ,   Embedded_stepper,   RK_embedded_OLP)
+*	ROS3:       ,      f(x, v) ,
+*	 I / (h gamma) - J      h (4  , 2     )
+*	SDIRK4:        I - h gamma J,      ;
+*	J         ,  -   h  J
+*	   , v_hat =     
+*	Method method - ROS3  SDIRK4
+*	F f -     f(x, v, dv),     jacobian (has_jacobian)
+*	std::size_t n -   (   N = Dynamic)
+*/
+template <std::size_t N, class F>
+class Stiff_stepper {
+public:
+	typedef State<N> state_type;
+	static const std::size_t dimension = N;
+
+	Stiff_stepper(Method method, F f, std::size_t n = N)
+		: method(method), f(f), n(N == Dynamic ? n : N), lu(this->n), J(make_matrix(this->n)), dfdx(make_state<N>(n)), f0(make_state<N>(n)), tmp(make_state<N>(n)),
+		z(make_state<N>(n)), v_jac(make_state<N>(n)), v_f0(make_state<N>(n)), v_step(make_state<N>(n)) {
+		for (state_type& k : K)
+			k = make_state<N>(n);
+		power = make_state<N>(n);
+		for (double& p : power)
+			p = 1;
+	}
+
+	std::size_t size() const { return n; }
+
+	/*
+	*	 error_order -   
+	*/
+	int error_order() const { return stiff_error_order(method); }
+
+	/*
+	*	 step -   (   Embedded_stepper::step)
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		if (method == Method::ROS3)
+			rosenbrock_step(x_n, h_n, v_n, v_next, v_hat);
+		else
+			sdirk_step(x_n, h_n, v_n, v_next, v_hat);
+		h_step = h_n;
+		v_step = v_n;
+	}
+
+	/*
+	*	 dense -  v   x_n + t h_n     ,    
+	*	(   f(x, v)          v  |J| h)
+	*/
+	void dense(double t, state_type& v) {
+		if (method == Method::ROS3) {
+			typedef ROS3_coefficients R;
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int j = 0; j < R::stages; j++)
+					sum += (R::dense[0][j] + t * R::dense[1][j]) * K[j][i];
+				v[i] = v_step[i] + t * sum;
+			}
+			return;
+		}
+		typedef SDIRK4_coefficients D;
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0;
+			for (int j = 0; j < D::stages; j++)
+				sum += (D::dense[0][j] + t * (D::dense[1][j] + t * D::dense[2][j])) * K[j][i];
+			v[i] = v_step[i] + h_step * t * sum;
+		}
+	}
+
+	/*
+	*	 spectral_radius -         :
+	*	     ,       
+	*/
+	double spectral_radius() {
+		double norm = 0;
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0;
+			for (std::size_t j = 0; j < n; j++)
+				sum += J[i * n + j] * power[j];
+			tmp[i] = sum;
+			norm = std::fmax(norm, std::abs(sum));
+		}
+		if (norm > 0)
+			for (std::size_t i = 0; i < n; i++)
+				power[i] = tmp[i] / norm;
+		return norm;
+	}
+
+	double tolerance = 1e-6;		//    SDIRK4 (  e)
+	std::size_t rhs_calls = 0;		//     (   )
+	std::size_t jacobians = 0;		//    
+	std::size_t factorizations = 0;	//  LU-
+
+private:
+	typedef Square_matrix<N> matrix_type;
+
+	static const int Max_newton = 10;	//    
+
+	static matrix_type make_matrix(std::size_t n) {
+		matrix_type m{};
+		if constexpr (N == Dynamic)
+			m.assign(n * n, 0.0);
+		(void)n;
+		return m;
+	}
+
+	/*
+	*	 rhs_at - f(x_n, v_n)  f0:        
+	*/
+	void rhs_at(double x_n, const state_type& v_n) {
+		if (x_n == x_f0 && v_n == v_f0)
+			return;
+		call_rhs(f, x_n, v_n.data(), f0.data());
+		rhs_calls++;
+		x_f0 = x_n;
+		v_f0 = v_n;
+	}
+
+	/*
+	*	 jacobian -     (x_n, v_n),  with_dfdx -  df/dx
+	*	(   f0 = f(x_n, v_n): n       df/dx)
+	*/
+	void jacobian(double x_n, const state_type& v_n, bool with_dfdx) {
+		if constexpr (has_jacobian<F>::value)
+			f.jacobian(x_n, v_n.data(), J.data(), dfdx.data());
+		else {
+			rhs_at(x_n, v_n);
+			tmp = v_n;
+			for (std::size_t j = 0; j < n; j++) {
+				const double delta = std::sqrt(DBL_EPSILON * std::fmax(1e-5, std::abs(v_n[j])));
+				tmp[j] = v_n[j] + delta;
+				call_rhs(f, x_n, tmp.data(), z.data());
+				tmp[j] = v_n[j];
+				for (std::size_t i = 0; i < n; i++)
+					J[i * n + j] = (z[i] - f0[i]) / delta;
+			}
+			rhs_calls += n;
+			if (with_dfdx) {
+				const double delta = std::sqrt(DBL_EPSILON * std::fmax(1e-5, std::abs(x_n)));
+				call_rhs(f, x_n + delta, v_n.data(), z.data());
+				for (std::size_t i = 0; i < n; i++)
+					dfdx[i] = (z[i] - f0[i]) / delta;
+				rhs_calls++;
+			}
+		}
+		jacobians++;
+		x_jac = x_n;
+		v_jac = v_n;
+		h_lu = 0;
+	}
+
+	/*
+	*	 factor -   diagonal I - scale J
+	*	 false,   
+	*/
+	bool factor(double h_n, double diagonal, double scale) {
+		double* m = lu.data();
+		for (std::size_t i = 0; i < n * n; i++)
+			m[i] = -scale * J[i];
+		for (std::size_t i = 0; i < n; i++)
+			m[i * n + i] += diagonal;
+		factorizations++;
+		h_lu = lu.factor() ? h_n : 0;
+		return h_lu != 0;
+	}
+
+	/*
+	*	 reject -  : v_next = v_n, v_hat = 
+	*/
+	void reject(const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		v_next = v_n;
+		for (std::size_t i = 0; i < n; i++)
+			v_hat[i] = INFINITY;
+	}
+
+	void rosenbrock_step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		typedef ROS3_coefficients R;
+		rhs_at(x_n, v_n);
+		if (!(x_n == x_jac && v_n == v_jac))
+			jacobian(x_n, v_n, true);
+		if (h_lu != h_n && !factor(h_n, 1 / (h_n * R::gamma), 1)) {
+			reject(v_n, v_next, v_hat);
+			return;
+		}
+
+		for (int s = 0; s < R::stages; s++) {
+			if (s == 0)
+				K[0] = f0;
+			else if (!R::new_f[s])
+				K[s] = z;
+			else {
+				for (std::size_t i = 0; i < n; i++) {
+					double sum = v_n[i];
+					for (int j = 0; j < s; j++)
+						sum += R::a[s][j] * K[j][i];
+					tmp[i] = sum;
+				}
+				call_rhs(f, x_n + R::alpha[s] * h_n, tmp.data(), K[s].data());
+				rhs_calls++;
+				z = K[s];
+			}
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int j = 0; j < s; j++)
+					sum += R::c[s][j] * K[j][i];
+				K[s][i] += sum / h_n + R::gamma_i[s] * h_n * dfdx[i];
+			}
+			lu.solve(K[s].data());
+		}
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0, err = 0;
+			for (int j = 0; j < R::stages; j++) {
+				sum += R::m[j] * K[j][i];
+				err += R::e[j] * K[j][i];
+			}
+			v_next[i] = v_n[i] + sum;
+			tmp[i] = err / (h_n * R::gamma);
+		}
+		//    L-:   (I - h gamma J)^-1,   SDIRK4
+		lu.solve(tmp.data());
+		for (std::size_t i = 0; i < n; i++)
+			v_hat[i] = v_next[i] - tmp[i];
+	}
+
+	void sdirk_step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		typedef SDIRK4_coefficients D;
+		const double hg = h_n * D::gamma;
+		if (jacobian_stale) {
+			jacobian(x_n, v_n, false);
+			jacobian_stale = false;
+		}
+		if (h_lu != h_n && !factor(h_n, 1, hg)) {
+			reject(v_n, v_next, v_hat);
+			return;
+		}
+
+		for (int s = 0; s < D::stages; s++) {
+			// base = v_n + h sum_{j<s} a_sj k_j,  z = base + h gamma k_s
+			for (std::size_t i = 0; i < n; i++) {
+				double sum = 0;
+				for (int j = 0; j < s; j++)
+					sum += D::a[s][j] * K[j][i];
+				tmp[i] = v_n[i] + h_n * sum;
+			}
+			//  : k_s = k_(s-1),    - k    
+			const state_type& guess = s > 0 ? K[s - 1] : K[D::stages - 1];
+			for (std::size_t i = 0; i < n; i++)
+				z[i] = tmp[i] + (s > 0 || x_n == x_last ? hg * guess[i] : 0);
+
+			double previous = 0;
+			bool converged = false;
+			for (int it = 0; it < Max_newton && !converged; it++) {
+				call_rhs(f, x_n + D::c[s] * h_n, z.data(), K[s].data());
+				rhs_calls++;
+				for (std::size_t i = 0; i < n; i++)
+					K[s][i] = tmp[i] + hg * K[s][i] - z[i];
+				lu.solve(K[s].data());
+				double norm = 0, scale = 0;
+				for (std::size_t i = 0; i < n; i++) {
+					z[i] += K[s][i];
+					norm = std::fmax(norm, std::abs(K[s][i]));
+					scale = std::fmax(scale, std::abs(z[i]));
+				}
+				if (!(norm == norm))
+					break;
+				double estimate = norm;
+				if (it > 0) {
+					const double theta = norm / previous;
+					if (theta >= 1)
+						break;
+					if (theta > 0.1)
+						jacobian_stale = true;
+					estimate = theta / (1 - theta) * norm;
+				}
+				//     z   
+				converged = estimate <= std::fmax(0.03 * tolerance, 16 * DBL_EPSILON * scale);
+				previous = norm;
+			}
+			if (!converged) {
+				// J     ,  J      
+				jacobian_stale = !(x_n == x_jac && v_n == v_jac);
+				x_last = NAN;
+				reject(v_n, v_next, v_hat);
+				return;
+			}
+			for (std::size_t i = 0; i < n; i++)
+				K[s][i] = (z[i] - tmp[i]) / hg;
+		}
+
+		v_next = z;
+		for (std::size_t i = 0; i < n; i++) {
+			double sum = 0;
+			for (int j = 0; j < D::stages; j++)
+				sum += (D::a[D::stages - 1][j] - D::b_hat[j]) * K[j][i];
+			tmp[i] = h_n * sum;
+		}
+		//  ,  (I - h gamma J)^-1,     
+		lu.solve(tmp.data());
+		for (std::size_t i = 0; i < n; i++)
+			v_hat[i] = v_next[i] - tmp[i];
+		x_last = x_n + h_n;
+	}
+
+	Method method;
+	F f;
+	std::size_t n;
+	Dense_LU<N> lu;
+	matrix_type J;
+	std::array<state_type, SDIRK4_coefficients::stages> K;	//  (ROS3 - U_i, SDIRK4 - k_i)
+	state_type dfdx, f0, tmp, z;
+	double x_jac = NAN, x_f0 = NAN, x_last = NAN;
+	double h_lu = 0;				// ,     (0 -  )
+	double h_step = 0;				//       ( dense)
+	bool jacobian_stale = true;
+	state_type v_jac, v_f0, v_step;
+	state_type power;				//    (spectral_radius), max|power| = 1
+};
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "RK_sweep.h"
+
+/*
+*	Work_range -     [begin, end)  
+*/
+struct Work_range {
+	std::mutex lock;
+	std::size_t begin = 0;
+	std::size_t end = 0;
+};
+
+/*
+*	 take -       
+*/
+static bool take(Work_range& range, std::size_t& i) {
+	std::lock_guard<std::mutex> guard(range.lock);
+	if (range.begin == range.end)
+		return false;
+	i = range.begin++;
+	return true;
+}
+
+/*
+*	 steal -       
+*/
+static bool steal(Work_range& victim, std::size_t& begin, std::size_t& end) {
+	std::lock_guard<std::mutex> guard(victim.lock);
+	if (victim.begin == victim.end)
+		return false;
+	std::size_t middle = victim.begin + (victim.end - victim.begin) / 2;
+	begin = middle;
+	end = victim.end;
+	victim.end = middle;
+	return true;
+}
+
+void parallel_for(std::size_t count, unsigned threads, const std::function<void(std::size_t)>& body) {
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+	if (threads <= 1) {
+		for (std::size_t i = 0; i < count; i++)
+			body(i);
+		return;
+	}
+
+	std::unique_ptr<Work_range[]> ranges(new Work_range[threads]);
+	for (unsigned w = 0; w < threads; w++) {
+		ranges[w].begin = count * w / threads;
+		ranges[w].end = count * (w + 1) / threads;
+	}
+	std::mutex error_lock;
+	std::exception_ptr error;
+
+	auto worker = [&](unsigned w) {
+		try {
+			while (true) {
+				std::size_t i;
+				if (take(ranges[w], i)) {
+					body(i);
+					continue;
+				}
+				bool stolen = false;
+				for (unsigned k = 1; k < threads && !stolen; k++) {
+					std::size_t begin, end;
+					if (steal(ranges[(w + k) % threads], begin, end)) {
+						std::lock_guard<std::mutex> guard(ranges[w].lock);
+						ranges[w].begin = begin;
+						ranges[w].end = end;
+						stolen = true;
+					}
+				}
+				if (!stolen)
+					return;
+			}
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> guard(error_lock);
+			if (!error)
+				error = std::current_exception();
+			//   ,     
+			for (unsigned k = 0; k < threads; k++) {
+				std::lock_guard<std::mutex> range_guard(ranges[k].lock);
+				ranges[k].begin = ranges[k].end;
+			}
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned w = 1; w < threads; w++)
+		pool.emplace_back(worker, w);
+	worker(0);
+	for (std::thread& thread : pool)
+		thread.join();
+	if (error)
+		std::rethrow_exception(error);
+}
+
+/*
+*	 grid_point - i-  count   min  max
+*/
+static double grid_point(double min, double max, std::size_t i, std::size_t count) {
+	return count <= 1 ? min : min + (max - min) * i / (count - 1);
+}
+
+std::vector<Sweep_cell> run_sweep(const Sweep_params& params, Step_stats* total) {
+	std::vector<std::pair<double, double>> initial = params.initial;
+	if (initial.empty())
+		initial.push_back({ params.task.u0_1, params.task.u0_2 });
+	const std::size_t plane = params.a_count * params.b_count;
+	std::vector<Sweep_cell> cells(plane * initial.size());
+	std::mutex total_lock;
+
+	parallel_for(cells.size(), params.threads, [&](std::size_t k) {
+		Sweep_cell& cell = cells[k];
+		cell.a = grid_point(params.a_min, params.a_max, k % params.a_count, params.a_count);
+		cell.b = grid_point(params.b_min, params.b_max, k % plane / params.a_count, params.b_count);
+		cell.u0_1 = initial[k / plane].first;
+		cell.u0_2 = initial[k / plane].second;
+
+		Task_params task = params.task;
+		task.a = cell.a;
+		task.b = cell.b;
+		task.u0_1 = cell.u0_1;
+		task.u0_2 = cell.u0_2;
+		Task_result result = run_task2_adaptive(task, false);
+
+		cell.x_n = task.xmax - result.b_x_n;
+		cell.v1 = result.v_n;
+		cell.v2 = result.v2_n;
+		cell.n = result.n;
+		cell.max_OLP = result.stats.max_OLP.value;
+		cell.min_h = result.stats.min_h.value;
+		cell.max_h = result.stats.max_h.value;
+		cell.rhs_calls = result.rhs_calls;
+		if (total != nullptr) {
+			std::lock_guard<std::mutex> guard(total_lock);
+			total->merge(result.stats);
+		}
+	});
+	return cells;
+}
+
+bool write_sweep(const std::string& path, const std::vector<Sweep_cell>& cells) {
+	std::FILE* file = std::fopen(path.c_str(), "w");
+	if (file == nullptr)
+		return false;
+	std::fprintf(file, "a,b,u0_1,u0_2,x_n,v1,v2,n,max_OLP,min_h,max_h,rhs_calls\n");
+	for (const Sweep_cell& cell : cells)
+		std::fprintf(file, "%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%zu,%.17g,%.17g,%.17g,%zu\n",
+			cell.a, cell.b, cell.u0_1, cell.u0_2, cell.x_n, cell.v1, cell.v2, cell.n, cell.max_OLP, cell.min_h, cell.max_h, cell.rhs_calls);
+	return std::fclose(file) == 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "RK_4_tasks.h"
+
+/*
+*	Sweep_params -   2     (button7)    (a, b)
+*	Task_params task -    (xmin, xmax, h, e, ,  ...)
+*	a_count   a_min  a_max  b_count   b_min  b_max ( count = 1 -  min)
+*	initial -   { u0_1, u0_2 };   - task.u0_1, task.u0_2
+*	unsigned threads -   (0 -   )
+*/
+struct Sweep_params {
+	Task_params task;
+	double a_min = 0;
+	double a_max = 1;
+	std::size_t a_count = 11;
+	double b_min = 0;
+	double b_max = 1;
+	std::size_t b_count = 11;
+	std::vector<std::pair<double, double>> initial;
+	unsigned threads = 0;
+};
+
+/*
+*	Sweep_cell -     
+*	   a,   b,    
+*/
+struct Sweep_cell {
+	double a = 0;
+	double b = 0;
+	double u0_1 = 0;
+	double u0_2 = 0;
+	double x_n = 0;			//      
+	double v1 = 0;
+	double v2 = 0;
+	std::size_t n = 0;		//  
+	double max_OLP = 0;
+	double min_h = 0;
+	double max_h = 0;
+	std::size_t rhs_calls = 0;
+};
+
+/*
+*	 parallel_for -  body(i)  i = 0 ... count - 1  threads  (0 -   )
+*	      ,   ,    
+*	   (work stealing),         
+*	  body      
+*/
+void parallel_for(std::size_t count, unsigned threads, const std::function<void(std::size_t)>& body);
+
+/*
+*	 run_sweep -    
+*	Step_stats* total -   nullptr,       (Step_stats::merge)
+*/
+std::vector<Sweep_cell> run_sweep(const Sweep_params& params, Step_stats* total = nullptr);
+
+/*
+*	 write_sweep -     CSV (   )
+*	 false,     
+*/
+bool write_sweep(const std::string& path, const std::vector<Sweep_cell>& cells);
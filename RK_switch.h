@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include "RK_4_system.h"
+
+/*
+*	 Switching_stepper -        (--method auto):
+*	 ,    ,   ,     
+*	 -  h |lambda|        :
+*	          (Embedded_stepper::stiffness,  ),
+*	 -       (Stiff_stepper::spectral_radius)
+*	    -  Switch_count   h |lambda| > Explicit_boundary
+*	(Nonstiff_reset      ,   DOPRI5 ),  -  Switch_count
+*	   h |lambda| < Explicit_margin,      
+*	   :         
+*	  ,     
+*	       ; implicit() -   
+*	Explicit& explicit_stepper - Embedded_stepper  DP54 (      3.3)
+*	Implicit& implicit_stepper - Stiff_stepper (ROS3)
+*/
+template <class Explicit, class Implicit>
+class Switching_stepper {
+public:
+	typedef typename Explicit::state_type state_type;
+	static const std::size_t dimension = Explicit::dimension;
+
+	Switching_stepper(Explicit& explicit_stepper, Implicit& implicit_stepper)
+		: explicit_stepper(explicit_stepper), implicit_stepper(implicit_stepper) {}
+
+	std::size_t size() const { return explicit_stepper.size(); }
+
+	int error_order() const { return stiff ? implicit_stepper.error_order() : explicit_stepper.error_order(); }
+
+	bool implicit() const { return stiff; }
+
+	/*
+	*	 step -   ,    
+	*/
+	void step(double x_n, double h_n, const state_type& v_n, state_type& v_next, state_type& v_hat) {
+		if (h_lambda >= 0)
+			assess();
+		if (stiff) {
+			implicit_stepper.step(x_n, h_n, v_n, v_next, v_hat);
+			h_lambda = h_n * implicit_stepper.spectral_radius();
+		}
+		else {
+			explicit_stepper.step(x_n, h_n, v_n, v_next, v_hat);
+			h_lambda = explicit_stepper.stiffness;
+		}
+		rhs_calls = explicit_stepper.rhs_calls + implicit_stepper.rhs_calls;
+	}
+
+	/*
+	*	 dense -       
+	*/
+	void dense(double t, state_type& v) {
+		if (stiff)
+			implicit_stepper.dense(t, v);
+		else
+			explicit_stepper.dense(t, v);
+		rhs_calls = explicit_stepper.rhs_calls + implicit_stepper.rhs_calls;
+	}
+
+	std::size_t rhs_calls = 0;	//      
+	std::size_t switches = 0;	//   
+
+private:
+	static constexpr double Explicit_boundary = 3.25;
+	static constexpr double Explicit_margin = 1;
+	static const int Switch_count = 15;
+	static const int Nonstiff_reset = 6;
+
+	/*
+	*	 assess -   h |lambda|     
+	*/
+	void assess() {
+		if (!stiff) {
+			if (h_lambda > Explicit_boundary) {
+				nonstiff = 0;
+				if (++count == Switch_count)
+					toggle();
+			}
+			else if (++nonstiff == Nonstiff_reset)
+				count = 0;
+		}
+		else if (h_lambda < Explicit_margin) {
+			if (++count == Switch_count)
+				toggle();
+		}
+		else
+			count = 0;
+	}
+
+	void toggle() {
+		stiff = !stiff;
+		count = 0;
+		nonstiff = 0;
+		switches++;
+	}
+
+	Explicit& explicit_stepper;
+	Implicit& implicit_stepper;
+	bool stiff = false;
+	int count = 0, nonstiff = 0;	//        
+	double h_lambda = -1;			//  h |lambda|    (-1 -    )
+};
@@ -0,0 +1,94 @@
+#include "RK_trajectory.h"
+#include "RK_trajectory_file.h"
+
+void Trajectory::set_columns(bool has_true_solution, bool is_system) {
+	true_solution = has_true_solution;
+	system = is_system;
+}
+
+void Trajectory::reserve(std::size_t n) {
+	i.reserve(n);
+	C1.reserve(n);
+	C2.reserve(n);
+	x.reserve(n);
+	v.reserve(n);
+	v_2h.reserve(n);
+	v_v_2h.reserve(n);
+	OLP.reserve(n);
+	h.reserve(n);
+	if (true_solution) {
+		u.reserve(n);
+		u_v.reserve(n);
+	}
+	if (system) {
+		v2.reserve(n);
+		v2_2h.reserve(n);
+	}
+}
+
+void Trajectory::push_back(const Table_row& row) {
+	i.push_back(row.i);
+	C1.push_back(row.C1);
+	C2.push_back(row.C2);
+	x.push_back(row.x);
+	v.push_back(row.v);
+	v_2h.push_back(row.v_2h);
+	v_v_2h.push_back(row.v_v_2h);
+	OLP.push_back(row.OLP);
+	h.push_back(row.h);
+	if (true_solution) {
+		u.push_back(row.u);
+		u_v.push_back(row.u_v);
+	}
+	if (system) {
+		v2.push_back(row.v2);
+		v2_2h.push_back(row.v2_2h);
+	}
+	if (sink != nullptr && size() == sink->chunk_rows()) {
+		if (!sink->write(*this))
+			write_failed = true;
+		clear();
+	}
+}
+
+void Trajectory::attach(Trajectory_writer* writer) {
+	sink = writer;
+	write_failed = false;
+}
+
+bool Trajectory::flush() {
+	if (sink == nullptr)
+		return true;
+	bool ok = sink->write(*this) && !write_failed;
+	clear();
+	return ok;
+}
+
+void Trajectory::clear() {
+	for (std::vector<std::size_t>* column : { &i, &C1, &C2 })
+		column->clear();
+	for (std::vector<double>* column : { &x, &v, &v_2h, &v_v_2h, &OLP, &h, &u, &u_v, &v2, &v2_2h })
+		column->clear();
+}
+
+Table_row Trajectory::row(std::size_t k) const {
+	Table_row row;
+	row.i = i[k];
+	row.x = x[k];
+	row.v = v[k];
+	row.v_2h = v_2h[k];
+	row.v_v_2h = v_v_2h[k];
+	row.OLP = OLP[k];
+	row.h = h[k];
+	row.C1 = C1[k];
+	row.C2 = C2[k];
+	if (true_solution) {
+		row.u = u[k];
+		row.u_v = u_v[k];
+	}
+	if (system) {
+		row.v2 = v2[k];
+		row.v2_2h = v2_2h[k];
+	}
+	return row;
+}
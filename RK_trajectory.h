@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/*
+*	Table_row -   dataGridView1
+*	  2 v, v_2h -  v1,  v2, v2_2h -   
+*	  save_at   i (  ), x, v, v2, h (,    ), u  |u - v|
+*/
+struct Table_row {
+	std::size_t i = 0;
+	double x = 0;
+	double v = 0;
+	double v_2h = 0;
+	double v_v_2h = 0;		// |v - v_2h|
+	double OLP = 0;			// 
+	double h = 0;
+	std::size_t C1 = 0;		//   
+	std::size_t C2 = 0;		//   
+	double u = 0;			//   (  )
+	double u_v = 0;			// |u - v|
+	double v2 = 0;
+	double v2_2h = 0;
+};
+
+class Trajectory_writer;
+
+/*
+*	 Trajectory -     
+*	  -  ,    (push_back),  ,
+*	        ,   
+*	 u, u_v       , v2, v2_2h -    2
+*/
+class Trajectory {
+public:
+	/*
+	*	 set_columns -      (  )
+	*/
+	void set_columns(bool has_true_solution, bool is_system);
+
+	/*
+	*	 reserve -   n     (   )
+	*/
+	void reserve(std::size_t n);
+
+	void push_back(const Table_row& row);
+	void clear();
+
+	/*
+	*	 attach -    :         
+	*	 flush -    ( ),  false,   
+	*	      
+	*/
+	void attach(Trajectory_writer* writer);
+	bool flush();
+	std::size_t size() const { return x.size(); }
+	bool empty() const { return x.empty(); }
+	bool has_true_solution() const { return true_solution; }
+	bool is_system() const { return system; }
+
+	/*
+	*	 row -  k (  - )
+	*/
+	Table_row row(std::size_t k) const;
+
+	std::vector<std::size_t> i, C1, C2;
+	std::vector<double> x, v, v_2h, v_v_2h, OLP, h;
+	std::vector<double> u, u_v;			//  has_true_solution
+	std::vector<double> v2, v2_2h;		//  is_system
+
+private:
+	bool true_solution = false;
+	bool system = false;
+	Trajectory_writer* sink = nullptr;
+	bool write_failed = false;	//      sink  
+};
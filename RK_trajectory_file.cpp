@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <cstring>
+#include "RK_trajectory_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char Trajectory_magic[8] = { 'R', 'K', 'T', 'R', 'A', 'J', '1', '\0' };
+static const std::size_t Column_name_size = 16;
+
+/*
+*	 little_endian -       little-endian
+*	(      )
+*/
+static bool little_endian() {
+	const std::uint16_t one = 1;
+	unsigned char first;
+	std::memcpy(&first, &one, 1);
+	return first == 1;
+}
+
+/*
+*	 put_*, get_* -        little-endian
+*/
+static void put_u32(unsigned char*& out, std::uint32_t value) {
+	for (int k = 0; k < 4; k++)
+		*out++ = static_cast<unsigned char>(value >> (8 * k));
+}
+
+static void put_u64(unsigned char*& out, std::uint64_t value) {
+	for (int k = 0; k < 8; k++)
+		*out++ = static_cast<unsigned char>(value >> (8 * k));
+}
+
+static void put_f64(unsigned char*& out, double value) {
+	std::uint64_t bits;
+	std::memcpy(&bits, &value, 8);
+	put_u64(out, bits);
+}
+
+static std::uint32_t get_u32(const unsigned char*& in) {
+	std::uint32_t value = 0;
+	for (int k = 0; k < 4; k++)
+		value |= static_cast<std::uint32_t>(*in++) << (8 * k);
+	return value;
+}
+
+static std::uint64_t get_u64(const unsigned char*& in) {
+	std::uint64_t value = 0;
+	for (int k = 0; k < 8; k++)
+		value |= static_cast<std::uint64_t>(*in++) << (8 * k);
+	return value;
+}
+
+static double get_f64(const unsigned char*& in) {
+	std::uint64_t bits = get_u64(in);
+	double value;
+	std::memcpy(&value, &bits, 8);
+	return value;
+}
+
+/*
+*	 trajectory_columns -     
+*/
+static std::vector<Column_info> trajectory_columns(bool has_true_solution, bool is_system) {
+	std::vector<Column_info> columns = {
+		{ "i", Column_type::U64 }, { "x", Column_type::F64 }, { "v", Column_type::F64 }, { "v_2h", Column_type::F64 },
+		{ "v-v_2h", Column_type::F64 }, { "OLP", Column_type::F64 }, { "h", Column_type::F64 },
+		{ "C1", Column_type::U64 }, { "C2", Column_type::U64 } };
+	if (has_true_solution) {
+		columns.push_back({ "u", Column_type::F64 });
+		columns.push_back({ "u-v", Column_type::F64 });
+	}
+	if (is_system) {
+		columns.push_back({ "v2", Column_type::F64 });
+		columns.push_back({ "v2_2h", Column_type::F64 });
+	}
+	return columns;
+}
+
+/*
+*	 column_values -   name   rows  nullptr,    
+*/
+static const void* column_values(const Trajectory& rows, const std::string& name) {
+	if (name == "i") return rows.i.data();
+	if (name == "x") return rows.x.data();
+	if (name == "v") return rows.v.data();
+	if (name == "v_2h") return rows.v_2h.data();
+	if (name == "v-v_2h") return rows.v_v_2h.data();
+	if (name == "OLP") return rows.OLP.data();
+	if (name == "h") return rows.h.data();
+	if (name == "C1") return rows.C1.data();
+	if (name == "C2") return rows.C2.data();
+	if (name == "u" && rows.has_true_solution()) return rows.u.data();
+	if (name == "u-v" && rows.has_true_solution()) return rows.u_v.data();
+	if (name == "v2" && rows.is_system()) return rows.v2.data();
+	if (name == "v2_2h" && rows.is_system()) return rows.v2_2h.data();
+	return nullptr;
+}
+
+Trajectory_writer::~Trajectory_writer() {
+	close();
+}
+
+bool Trajectory_writer::open(const std::string& path, int task, const Task_params& params, std::size_t chunk_rows, bool compress) {
+	close();
+	if (!little_endian() || chunk_rows == 0)
+		return false;
+	file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr)
+		return false;
+	ok = true;
+	header = Trajectory_header();
+	header.version = compress ? 2 : 1;
+	header.task = task;
+	header.method = params.method;
+	header.control = params.control;
+	header.xmin = params.xmin;
+	header.xmax = params.xmax;
+	header.h0 = params.h;
+	header.e = params.e;
+	header.u0 = params.u0;
+	header.u0_1 = params.u0_1;
+	header.u0_2 = params.u0_2;
+	header.a = params.a;
+	header.b = params.b;
+	header.chunk_rows = chunk_rows;
+	header.columns = trajectory_columns(task == 1 || task == 3, task == 2 || task == 6 || task == 7);
+
+	//   ,     close,    
+	unsigned char zeros[Trajectory_header_size] = {};
+	ok = std::fwrite(zeros, 1, sizeof(zeros), file) == sizeof(zeros);
+	return ok;
+}
+
+bool Trajectory_writer::write(const Trajectory& rows) {
+	if (file == nullptr || rows.empty())
+		return file != nullptr;
+	//      
+	if (header.rows % header.chunk_rows != 0 || rows.size() > header.chunk_rows) {
+		ok = false;
+		return false;
+	}
+	if (header.version == 2)
+		return write_compressed(rows);
+	const std::size_t n = rows.size();
+	for (const Column_info& column : header.columns) {
+		const void* data = column_values(rows, column.name);
+		if (data == nullptr) {
+			ok = false;
+			return false;
+		}
+		if (column.type == Column_type::U64 && sizeof(std::size_t) != 8) {
+			for (std::size_t k = 0; k < n && ok; k++) {
+				std::uint64_t value = static_cast<const std::size_t*>(data)[k];
+				ok = std::fwrite(&value, 8, 1, file) == 1;
+			}
+		}
+		else
+			ok = ok && std::fwrite(data, 8, n, file) == n;
+	}
+	header.rows += n;
+	header.chunks++;
+	return ok;
+}
+
+bool Trajectory_writer::write_compressed(const Trajectory& rows) {
+	const std::size_t n = rows.size();
+	const std::size_t ncols = header.columns.size();
+	//  :  ,    -    
+	buffer.assign(8 + 16 * ncols, 0);
+	unsigned char* out = buffer.data();
+	put_u64(out, n);
+	std::vector<std::uint64_t> counts;
+	for (std::size_t j = 0; j < ncols && ok; j++) {
+		const void* data = column_values(rows, header.columns[j].name);
+		if (data == nullptr) {
+			ok = false;
+			return false;
+		}
+		if (header.columns[j].type == Column_type::U64 && sizeof(std::size_t) != 8) {
+			counts.assign(static_cast<const std::size_t*>(data), static_cast<const std::size_t*>(data) + n);
+			data = counts.data();
+		}
+		std::size_t start = buffer.size();
+		Column_encoding encoding = encode_column(data, n, header.columns[j].type == Column_type::F64, buffer);
+		std::size_t bytes = buffer.size() - start;
+		buffer.resize(start + (bytes + 7) / 8 * 8, 0);
+		out = buffer.data() + 8 + 16 * j;
+		put_u32(out, static_cast<std::uint32_t>(encoding));
+		put_u32(out, 0);
+		put_u64(out, bytes);
+	}
+	ok = ok && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+	header.rows += n;
+	header.chunks++;
+	return ok;
+}
+
+bool Trajectory_writer::close() {
+	if (file == nullptr)
+		return ok;
+	unsigned char buffer[Trajectory_header_size] = {};
+	unsigned char* out = buffer;
+	std::memcpy(out, Trajectory_magic, sizeof(Trajectory_magic));
+	out += sizeof(Trajectory_magic);
+	put_u32(out, header.version);
+	put_u32(out, static_cast<std::uint32_t>(Trajectory_header_size));
+	put_u32(out, static_cast<std::uint32_t>(header.task));
+	put_u32(out, static_cast<std::uint32_t>(header.method));
+	put_u32(out, static_cast<std::uint32_t>(header.control));
+	put_u32(out, static_cast<std::uint32_t>(header.columns.size()));
+	for (double value : { header.xmin, header.xmax, header.h0, header.e, header.u0, header.u0_1, header.u0_2, header.a, header.b })
+		put_f64(out, value);
+	put_u64(out, header.rows);
+	put_u64(out, header.chunks);
+	put_u64(out, header.chunk_rows);
+	for (const Column_info& column : header.columns) {
+		std::strncpy(reinterpret_cast<char*>(out), column.name.c_str(), Column_name_size - 1);
+		out += Column_name_size;
+		put_u32(out, static_cast<std::uint32_t>(column.type));
+		put_u32(out, 8);
+	}
+
+	ok = ok && std::fseek(file, 0, SEEK_SET) == 0;
+	ok = ok && std::fwrite(buffer, 1, sizeof(buffer), file) == sizeof(buffer);
+	ok = (std::fclose(file) == 0) && ok;
+	file = nullptr;
+	return ok;
+}
+
+Trajectory_file::~Trajectory_file() {
+	close();
+}
+
+bool Trajectory_file::open(const std::string& path) {
+	close();
+	if (!little_endian()) {
+		message = "big-endian hosts are not supported";
+		return false;
+	}
+#ifdef _WIN32
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		message = "cannot open " + path;
+		return false;
+	}
+	file_handle = handle;
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(handle, &file_size) || file_size.QuadPart < (LONGLONG)Trajectory_header_size) {
+		message = path + " is not a trajectory file";
+		close();
+		return false;
+	}
+	size = static_cast<std::size_t>(file_size.QuadPart);
+	mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping != nullptr)
+		data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		message = "cannot map " + path;
+		close();
+		return false;
+	}
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		message = "cannot open " + path;
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t)Trajectory_header_size) {
+		::close(fd);
+		message = path + " is not a trajectory file";
+		return false;
+	}
+	size = static_cast<std::size_t>(info.st_size);
+	void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED) {
+		message = "cannot map " + path;
+		size = 0;
+		return false;
+	}
+	data = static_cast<const unsigned char*>(mapped);
+#endif
+
+	const unsigned char* in = data;
+	if (std::memcmp(in, Trajectory_magic, sizeof(Trajectory_magic)) != 0) {
+		message = path + " is not a trajectory file";
+		close();
+		return false;
+	}
+	in += sizeof(Trajectory_magic);
+	head = Trajectory_header();
+	head.version = get_u32(in);
+	std::uint32_t header_size = get_u32(in);
+	if ((head.version != 1 && head.version != 2) || header_size != Trajectory_header_size) {
+		message = "unsupported trajectory file version";
+		close();
+		return false;
+	}
+	head.task = static_cast<int>(get_u32(in));
+	head.method = static_cast<Method>(get_u32(in));
+	head.control = static_cast<Control>(get_u32(in));
+	std::uint32_t column_count = get_u32(in);
+	for (double* value : { &head.xmin, &head.xmax, &head.h0, &head.e, &head.u0, &head.u0_1, &head.u0_2, &head.a, &head.b })
+		*value = get_f64(in);
+	head.rows = get_u64(in);
+	head.chunks = get_u64(in);
+	head.chunk_rows = get_u64(in);
+	if (column_count * (Column_name_size + 8) > Trajectory_header_size - (in - data) || head.chunk_rows == 0) {
+		message = "corrupt trajectory header";
+		close();
+		return false;
+	}
+	for (std::uint32_t j = 0; j < column_count; j++) {
+		Column_info column;
+		column.name.assign(reinterpret_cast<const char*>(in), strnlen(reinterpret_cast<const char*>(in), Column_name_size));
+		in += Column_name_size;
+		column.type = static_cast<Column_type>(get_u32(in));
+		get_u32(in);
+		head.columns.push_back(column);
+	}
+
+	//      
+	bool consistent = head.chunks == (head.rows + head.chunk_rows - 1) / head.chunk_rows && index_chunks();
+	if (!consistent) {
+		message = "truncated trajectory file";
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool Trajectory_file::index_chunks() {
+	const std::size_t ncols = head.columns.size();
+	stored.clear();
+	stored.reserve(chunks() * ncols);
+	std::size_t offset = Trajectory_header_size;
+	for (std::size_t k = 0; k < chunks(); k++) {
+		const std::size_t n = chunk_size(k);
+		if (head.version == 1) {
+			for (std::size_t j = 0; j < ncols; j++)
+				stored.push_back({ offset + j * 8 * n, 8 * n, Column_encoding::Raw });
+			offset += 8 * n * ncols;
+			continue;
+		}
+		if (offset > size || size - offset < 8 + 16 * ncols)
+			return false;
+		const unsigned char* in = data + offset;
+		if (get_u64(in) != n)
+			return false;
+		offset += 8 + 16 * ncols;
+		for (std::size_t j = 0; j < ncols; j++) {
+			Column_encoding encoding = static_cast<Column_encoding>(get_u32(in));
+			get_u32(in);
+			std::uint64_t bytes = get_u64(in);
+			if (encoding > Column_encoding::Delta_RLE || bytes > size - offset)
+				return false;
+			stored.push_back({ offset, static_cast<std::size_t>(bytes), encoding });
+			offset += static_cast<std::size_t>((bytes + 7) / 8 * 8);
+		}
+	}
+	return offset <= size;
+}
+
+void Trajectory_file::close() {
+#ifdef _WIN32
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	if (file_handle != nullptr)
+		CloseHandle(file_handle);
+	mapping = nullptr;
+	file_handle = nullptr;
+#else
+	if (data != nullptr)
+		munmap(const_cast<unsigned char*>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+	stored.clear();
+	cache_column = -1;
+}
+
+std::size_t Trajectory_file::chunk_size(std::size_t k) const {
+	std::size_t first = chunk_first_row(k);
+	return std::min(static_cast<std::size_t>(head.chunk_rows), rows() - first);
+}
+
+int Trajectory_file::column_index(const std::string& name) const {
+	for (std::size_t j = 0; j < head.columns.size(); j++)
+		if (head.columns[j].name == name)
+			return static_cast<int>(j);
+	return -1;
+}
+
+const double* Trajectory_file::f64(int j, std::size_t k) const {
+	if (j < 0 || j >= (int)head.columns.size() || head.columns[j].type != Column_type::F64 || k >= chunks()
+		|| encoding(j, k) != Column_encoding::Raw)
+		return nullptr;
+	return reinterpret_cast<const double*>(data + stored[k * head.columns.size() + j].offset);
+}
+
+const std::uint64_t* Trajectory_file::u64(int j, std::size_t k) const {
+	if (j < 0 || j >= (int)head.columns.size() || head.columns[j].type != Column_type::U64 || k >= chunks()
+		|| encoding(j, k) != Column_encoding::Raw)
+		return nullptr;
+	return reinterpret_cast<const std::uint64_t*>(data + stored[k * head.columns.size() + j].offset);
+}
+
+bool Trajectory_file::read_column(int j, std::size_t k, Column_type type, void* out) const {
+	if (j < 0 || j >= (int)head.columns.size() || head.columns[j].type != type || k >= chunks())
+		return false;
+	const Stored_column& column = stored[k * head.columns.size() + j];
+	return decode_column(column.encoding, data + column.offset, column.bytes, out, chunk_size(k));
+}
+
+bool Trajectory_file::read_f64(int j, std::size_t k, std::vector<double>& out) const {
+	out.resize(k < chunks() ? chunk_size(k) : 0);
+	return read_column(j, k, Column_type::F64, out.data());
+}
+
+bool Trajectory_file::read_u64(int j, std::size_t k, std::vector<std::uint64_t>& out) const {
+	out.resize(k < chunks() ? chunk_size(k) : 0);
+	return read_column(j, k, Column_type::U64, out.data());
+}
+
+double Trajectory_file::value(int j, std::size_t row) const {
+	std::size_t k = row / static_cast<std::size_t>(head.chunk_rows);
+	std::size_t offset = row % static_cast<std::size_t>(head.chunk_rows);
+	const bool is_u64 = head.columns[j].type == Column_type::U64;
+	if (encoding(j, k) == Column_encoding::Raw)
+		return is_u64 ? static_cast<double>(u64(j, k)[offset]) : f64(j, k)[offset];
+
+	if (cache_column != j || cache_chunk != k) {
+		cache.resize(chunk_size(k));
+		cache_column = read_column(j, k, head.columns[j].type, cache.data()) ? j : -1;
+		cache_chunk = k;
+		if (cache_column < 0)
+			return 0;
+	}
+	if (is_u64)
+		return static_cast<double>(cache[offset]);
+	double value;
+	std::memcpy(&value, &cache[offset], 8);
+	return value;
+}
@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "RK_4_tasks.h"
+#include "RK_compress.h"
+
+/*
+*	    ( 1  2),   - little-endian
+*	 (Trajectory_header_size ):  "RKTRAJ1\0", ,  ,
+*	 , ,  , xmin, xmax, h0, e, u0, u0_1, u0_2, a, b,
+*	 ,  ,    ,      (, )
+*	   :   k   -    rows_in_chunk(k) 
+*	(double  uint64),    ,        
+*	 2 ( ):         ( Column_encoding,   ),
+*	  ,    8 ;  Raw -   
+*/
+const std::size_t Trajectory_header_size = 512;
+const std::size_t Trajectory_chunk_rows = 65536;
+
+enum class Column_type : std::uint32_t { F64 = 0, U64 = 1 };
+
+struct Column_info {
+	std::string name;
+	Column_type type;
+};
+
+/*
+*	Trajectory_header -   
+*/
+struct Trajectory_header {
+	std::uint32_t version = 1;		// 2 -   
+	int task = 0;					//   
+	Method method = Method::RK4;
+	Control control = Control::Halving;
+	double xmin = 0;
+	double xmax = 0;
+	double h0 = 0;
+	double e = 0;
+	double u0 = 0;
+	double u0_1 = 0;
+	double u0_2 = 0;
+	double a = 0;
+	double b = 0;
+	std::uint64_t rows = 0;
+	std::uint64_t chunks = 0;
+	std::uint64_t chunk_rows = Trajectory_chunk_rows;
+	std::vector<Column_info> columns;
+};
+
+/*
+*	 Trajectory_writer -     
+*	    chunk_rows,       
+*	(Trajectory::attach      ),    close
+*/
+class Trajectory_writer {
+public:
+	Trajectory_writer() = default;
+	Trajectory_writer(const Trajectory_writer&) = delete;
+	Trajectory_writer& operator=(const Trajectory_writer&) = delete;
+	~Trajectory_writer();
+
+	/*
+	*	 open -     task    params
+	*	 false,     
+	*	compress -   2,     (encode_column)
+	*/
+	bool open(const std::string& path, int task, const Task_params& params, std::size_t chunk_rows = Trajectory_chunk_rows,
+		bool compress = false);
+
+	/*
+	*	 write -   rows   (  chunk_rows )
+	*/
+	bool write(const Trajectory& rows);
+
+	/*
+	*	 close -     
+	*	 false,  -   
+	*/
+	bool close();
+
+	std::size_t chunk_rows() const { return static_cast<std::size_t>(header.chunk_rows); }
+	bool is_open() const { return file != nullptr; }
+
+private:
+	bool write_compressed(const Trajectory& rows);
+
+	std::FILE* file = nullptr;
+	Trajectory_header header;
+	std::vector<unsigned char> buffer;
+	bool ok = true;
+};
+
+/*
+*	 Trajectory_file -        (mmap)
+*	     ,  
+*/
+class Trajectory_file {
+public:
+	Trajectory_file() = default;
+	Trajectory_file(const Trajectory_file&) = delete;
+	Trajectory_file& operator=(const Trajectory_file&) = delete;
+	~Trajectory_file();
+
+	/*
+	*	 open -  ,  false,     ( - error())
+	*/
+	bool open(const std::string& path);
+	void close();
+	const std::string& error() const { return message; }
+
+	const Trajectory_header& header() const { return head; }
+	std::size_t rows() const { return static_cast<std::size_t>(head.rows); }
+	std::size_t chunks() const { return static_cast<std::size_t>(head.chunks); }
+
+	/*
+	*	 chunk_size -     k
+	*	 chunk_first_row -     k
+	*/
+	std::size_t chunk_size(std::size_t k) const;
+	std::size_t chunk_first_row(std::size_t k) const { return k * static_cast<std::size_t>(head.chunk_rows); }
+
+	/*
+	*	 column_index -    , -1   
+	*/
+	int column_index(const std::string& name) const;
+
+	/*
+	*	 encoding -    j   k
+	*/
+	Column_encoding encoding(int j, std::size_t k) const { return stored[k * head.columns.size() + j].encoding; }
+
+	/*
+	*	 f64, u64 -  j  k (chunk_size(k) )
+	*	 nullptr,        ( read_f64, read_u64)
+	*/
+	const double* f64(int j, std::size_t k) const;
+	const std::uint64_t* u64(int j, std::size_t k) const;
+
+	/*
+	*	 read_f64, read_u64 -  j  k  out (,  )
+	*	 false,       
+	*/
+	bool read_f64(int j, std::size_t k, std::vector<double>& out) const;
+	bool read_u64(int j, std::size_t k, std::vector<std::uint64_t>& out) const;
+
+	/*
+	*	 value -   j   row ( uint64   double)
+	*	    ,    
+	*/
+	double value(int j, std::size_t row) const;
+
+private:
+	/*
+	*	Stored_column -     
+	*/
+	struct Stored_column {
+		std::size_t offset;
+		std::size_t bytes;
+		Column_encoding encoding;
+	};
+
+	bool index_chunks();
+	bool read_column(int j, std::size_t k, Column_type type, void* out) const;
+
+	Trajectory_header head;
+	std::vector<Stored_column> stored;	//  k,  j - stored[k *   + j]
+	mutable std::vector<std::uint64_t> cache;
+	mutable int cache_column = -1;
+	mutable std::size_t cache_chunk = 0;
+	std::string message;
+	const unsigned char* data = nullptr;
+	std::size_t size = 0;
+#ifdef _WIN32
+	void* file_handle = nullptr;
+	void* mapping = nullptr;
+#endif
+};